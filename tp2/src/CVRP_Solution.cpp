@@ -1,41 +1,349 @@
 #include "CVRP_Solution.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 using namespace std;
 
 Solution::Solution() : costoTotal(0.0) {
     // Constructor: inicializa con costo cero y sin rutas
+    inicio.push_back(0);
 }
 
-void Solution::agregarRuta(const std::vector<int>& ruta, const std::vector<std::vector<double>>& distancias, int suma_demanda) {
-    rutas.push_back(ruta);
+Solution Solution::clone() const {
+    Solution copia;
+    copia.nodos = nodos;
+    copia.inicio = inicio;
+    copia.costos = costos;
+    copia.demandas = demandas;
+    copia.costoTotal = costoTotal;
+    copia.rutaDe = rutaDe;
+    copia.posicion = posicion;
+    copia.predecesor = predecesor;
+    copia.sucesor = sucesor;
+    copia.distancias = distancias;
+    copia.demandaCliente = demandaCliente;
+    copia.capacidad = capacidad;
+    copia.cargaAcum = cargaAcum;
+    return copia;
+}
+
+void Solution::enlazar(const DistanceMatrix& distancias, const std::vector<int>& demandas, int capacidad) {
+    this->distancias = &distancias;
+    demandaCliente = &demandas;
+    this->capacidad = capacidad;
+    cargaAcum.assign(nodos.size(), 0);
+    for (int r = 0; r < cantidadRutas(); ++r) recalcularCargas(r, 0);
+}
+
+void Solution::reservar(int cantidadNodos, int cantidadRutas) {
+    nodos.reserve(cantidadNodos);
+    cargaAcum.reserve(cantidadNodos);
+    inicio.reserve(cantidadRutas + 1);
+    costos.reserve(cantidadRutas);
+    demandas.reserve(cantidadRutas);
+}
+
+void Solution::limpiar() {
+    nodos.clear();
+    cargaAcum.clear();
+    inicio.assign(1, 0);
+    costos.clear();
+    demandas.clear();
+    costoTotal = 0.0;
+    fill(rutaDe.begin(), rutaDe.end(), -1);
+}
+
+void Solution::agregarRuta(const std::vector<int>& ruta, const DistanceMatrix& distancias, int suma_demanda) {
+    nodos.insert(nodos.end(), ruta.begin(), ruta.end());
+    inicio.push_back(static_cast<int>(nodos.size()));
+    double costo = calcularCostoRuta(ruta, distancias);
+    costos.push_back(costo);
     demandas.push_back(suma_demanda);
-    costoTotal += calcularCostoRuta(ruta, distancias);
+    costoTotal += costo;
+    indexarRuta(cantidadRutas() - 1);
+    cargaAcum.resize(nodos.size(), 0);
+    if (enlazada()) recalcularCargas(cantidadRutas() - 1, 0);
+}
+
+void Solution::indexarRuta(int r) {
+    int desde = inicio[r], hasta = inicio[r + 1];
+    int maximo = -1;
+    for (int p = desde + 1; p + 1 < hasta; ++p) maximo = max(maximo, nodos[p]);
+    if (maximo >= static_cast<int>(rutaDe.size())) {
+        rutaDe.resize(maximo + 1, -1);
+        posicion.resize(maximo + 1, -1);
+        predecesor.resize(maximo + 1, -1);
+        sucesor.resize(maximo + 1, -1);
+    }
+    reindexar(r, 1, hasta - desde - 2);
+}
+
+void Solution::reindexar(int r, int desde, int hasta) {
+    desde = max(desde, 1);
+    hasta = min(hasta, largo(r) - 2);
+    const int* ruta = nodos.data() + inicio[r];
+    for (int p = desde; p <= hasta; ++p) {
+        int c = ruta[p];
+        rutaDe[c] = r;
+        posicion[c] = p;
+        predecesor[c] = ruta[p - 1];
+        sucesor[c] = ruta[p + 1];
+    }
+}
+
+void Solution::recalcularCargas(int r, int desde) {
+    int base = inicio[r];
+    int acumulada = desde > 0 ? cargaAcum[base + desde - 1] : 0;
+    for (int p = max(desde, 1); p + 1 < largo(r); ++p) {
+        acumulada += q(nodos[base + p]);
+        cargaAcum[base + p] = acumulada;
+    }
+    cargaAcum[base] = 0;
+    cargaAcum[inicio[r + 1] - 1] = acumulada;
+    demandas[r] = acumulada;
+}
+
+void Solution::reescribirRuta(int r, const std::vector<int>& nueva) {
+    int diferencia = static_cast<int>(nueva.size()) - largo(r);
+    if (diferencia > 0) {
+        nodos.insert(nodos.begin() + inicio[r + 1], diferencia, 0);
+        cargaAcum.insert(cargaAcum.begin() + inicio[r + 1], diferencia, 0);
+    } else if (diferencia < 0) {
+        nodos.erase(nodos.begin() + inicio[r + 1] + diferencia, nodos.begin() + inicio[r + 1]);
+        cargaAcum.erase(cargaAcum.begin() + inicio[r + 1] + diferencia, cargaAcum.begin() + inicio[r + 1]);
+    }
+    // Las posiciones guardadas son relativas a cada ruta: las siguientes no cambian
+    for (size_t k = r + 1; k < inicio.size(); ++k) inicio[k] += diferencia;
+    copy(nueva.begin(), nueva.end(), nodos.begin() + inicio[r]);
+    reindexar(r, 1, largo(r) - 2);
+    recalcularCargas(r, 0);
+}
+
+double Solution::costoDe(int r) const {
+    double total = 0.0;
+    for (int p = 0; p + 1 < largo(r); ++p) total += d(nodo(r, p), nodo(r, p + 1));
+    return total;
+}
+
+// --- Swap ---
+
+bool Solution::factible(const MovSwap& m) const {
+    int ra = rutaDe[m.a], rb = rutaDe[m.b];
+    if (ra == rb) return true;
+    int diferencia = q(m.b) - q(m.a);
+    return demandas[ra] + diferencia <= capacidad && demandas[rb] - diferencia <= capacidad;
+}
+
+double Solution::delta(const MovSwap& m) const {
+    int a = m.a, b = m.b;
+    if (sucesor[b] == a && rutaDe[a] == rutaDe[b]) swap(a, b);
+    int pa = predecesor[a], na = sucesor[a], pb = predecesor[b], nb = sucesor[b];
+    if (rutaDe[a] == rutaDe[b] && na == b) {
+        // Adyacentes: pa a b nb -> pa b a nb
+        return d(pa, b) + d(b, a) + d(a, nb) - d(pa, a) - d(a, b) - d(b, nb);
+    }
+    return d(pa, b) + d(b, na) - d(pa, a) - d(a, na) + d(pb, a) + d(a, nb) - d(pb, b) - d(b, nb);
+}
+
+void Solution::aplicar(MovSwap& m) {
+    int ra = rutaDe[m.a], rb = rutaDe[m.b];
+    int pa = posicion[m.a], pb = posicion[m.b];
+    double cambio = delta(m);
+    if (ra == rb) {
+        costos[ra] += cambio;
+    } else {
+        // La parte de cada ruta: sus dos aristas nuevas menos las viejas
+        double parteA = d(predecesor[m.a], m.b) + d(m.b, sucesor[m.a]) - d(predecesor[m.a], m.a) - d(m.a, sucesor[m.a]);
+        costos[ra] += parteA;
+        costos[rb] += cambio - parteA;
+    }
+    costoTotal += cambio;
+    swap(nodos[inicio[ra] + pa], nodos[inicio[rb] + pb]);
+    reindexar(ra, pa - 1, pa + 1);
+    reindexar(rb, pb - 1, pb + 1);
+    recalcularCargas(ra, ra == rb ? min(pa, pb) : pa);
+    if (rb != ra) recalcularCargas(rb, pb);
+    assert(verificar());
+}
+
+void Solution::deshacer(const MovSwap& m) {
+    MovSwap inverso = m;
+    aplicar(inverso);
+}
+
+// --- Relocate ---
+
+bool Solution::factible(const MovRelocate& m) const {
+    if (m.ruta < 0 || m.ruta >= cantidadRutas()) return false;
+    int origen = rutaDe[m.cliente];
+    int maximo = m.ruta == origen ? largo(m.ruta) - 2 : largo(m.ruta) - 1;
+    if (m.posicion < 1 || m.posicion > maximo) return false;
+    return m.ruta == origen || demandas[m.ruta] + q(m.cliente) <= capacidad;
+}
+
+double Solution::delta(const MovRelocate& m) const {
+    int c = m.cliente;
+    int origen = rutaDe[c], p0 = posicion[c];
+    double sacar = d(predecesor[c], sucesor[c]) - d(predecesor[c], c) - d(c, sucesor[c]);
+    // Vecinos en la ruta destino ya sin el cliente
+    auto sinCliente = [&](int p) { return m.ruta == origen && p >= p0 ? nodo(m.ruta, p + 1) : nodo(m.ruta, p); };
+    int antes = sinCliente(m.posicion - 1), despues = sinCliente(m.posicion);
+    return sacar + d(antes, c) + d(c, despues) - d(antes, despues);
+}
+
+void Solution::aplicar(MovRelocate& m) {
+    int c = m.cliente;
+    int origen = rutaDe[c], p0 = posicion[c];
+    double cambio = delta(m);
+    double sacar = d(predecesor[c], sucesor[c]) - d(predecesor[c], c) - d(c, sucesor[c]);
+    m.ruta_origen = origen;
+    m.posicion_origen = p0;
+
+    VistaRuta vieja = ruta(origen);
+    auxiliar1.assign(vieja.begin(), vieja.end());
+    auxiliar1.erase(auxiliar1.begin() + p0);
+    if (m.ruta == origen) {
+        auxiliar1.insert(auxiliar1.begin() + m.posicion, c);
+        reescribirRuta(origen, auxiliar1);
+        costos[origen] += cambio;
+    } else {
+        VistaRuta destino = ruta(m.ruta);
+        auxiliar2.assign(destino.begin(), destino.end());
+        auxiliar2.insert(auxiliar2.begin() + m.posicion, c);
+        reescribirRuta(origen, auxiliar1);
+        reescribirRuta(m.ruta, auxiliar2);
+        costos[origen] += sacar;
+        costos[m.ruta] += cambio - sacar;
+    }
+    costoTotal += cambio;
+    assert(verificar());
+}
+
+void Solution::deshacer(const MovRelocate& m) {
+    MovRelocate inverso{m.cliente, m.ruta_origen, m.posicion_origen};
+    aplicar(inverso);
+}
+
+// --- 2-opt ---
+
+bool Solution::factible(const Mov2opt& m) const {
+    return m.ruta >= 0 && m.ruta < cantidadRutas() && 1 <= m.i && m.i < m.j && m.j <= largo(m.ruta) - 2;
+}
+
+double Solution::delta(const Mov2opt& m) const {
+    int a = nodo(m.ruta, m.i - 1), b = nodo(m.ruta, m.i);
+    int c = nodo(m.ruta, m.j), e = nodo(m.ruta, m.j + 1);
+    return d(a, c) + d(b, e) - d(a, b) - d(c, e);
+}
+
+void Solution::aplicar(Mov2opt& m) {
+    double cambio = delta(m);
+    reverse(nodos.begin() + inicio[m.ruta] + m.i, nodos.begin() + inicio[m.ruta] + m.j + 1);
+    costos[m.ruta] += cambio;
+    costoTotal += cambio;
+    reindexar(m.ruta, m.i - 1, m.j + 1);
+    recalcularCargas(m.ruta, m.i);
+    assert(verificar());
+}
+
+void Solution::deshacer(const Mov2opt& m) {
+    Mov2opt inverso = m;
+    aplicar(inverso);
+}
+
+// --- 2-opt* ---
+
+bool Solution::factible(const Mov2optEstrella& m) const {
+    if (m.ruta1 == m.ruta2 || m.ruta1 < 0 || m.ruta2 < 0 ||
+        m.ruta1 >= cantidadRutas() || m.ruta2 >= cantidadRutas()) return false;
+    if (m.i < 0 || m.i > largo(m.ruta1) - 2 || m.j < 0 || m.j > largo(m.ruta2) - 2) return false;
+    int cabeza1 = cargaHasta(m.ruta1, m.i), cabeza2 = cargaHasta(m.ruta2, m.j);
+    return cabeza1 + demandas[m.ruta2] - cabeza2 <= capacidad &&
+           cabeza2 + demandas[m.ruta1] - cabeza1 <= capacidad;
+}
+
+double Solution::delta(const Mov2optEstrella& m) const {
+    int a = nodo(m.ruta1, m.i), b = nodo(m.ruta1, m.i + 1);
+    int c = nodo(m.ruta2, m.j), e = nodo(m.ruta2, m.j + 1);
+    return d(a, e) + d(c, b) - d(a, b) - d(c, e);
+}
+
+void Solution::aplicar(Mov2optEstrella& m) {
+    VistaRuta r1 = ruta(m.ruta1), r2 = ruta(m.ruta2);
+    auxiliar1.assign(r1.begin(), r1.begin() + m.i + 1);
+    auxiliar1.insert(auxiliar1.end(), r2.begin() + m.j + 1, r2.end());
+    auxiliar2.assign(r2.begin(), r2.begin() + m.j + 1);
+    auxiliar2.insert(auxiliar2.end(), r1.begin() + m.i + 1, r1.end());
+    // Las colas cambian de ruta con sus aristas: los costos se recalculan
+    reescribirRuta(m.ruta1, auxiliar1);
+    reescribirRuta(m.ruta2, auxiliar2);
+    double nuevo1 = costoDe(m.ruta1), nuevo2 = costoDe(m.ruta2);
+    costoTotal += nuevo1 + nuevo2 - costos[m.ruta1] - costos[m.ruta2];
+    costos[m.ruta1] = nuevo1;
+    costos[m.ruta2] = nuevo2;
+    assert(verificar());
+}
+
+void Solution::deshacer(const Mov2optEstrella& m) {
+    Mov2optEstrella inverso = m;
+    aplicar(inverso);
 }
 
+bool Solution::verificar(double tolerancia) const {
+    double total = 0.0;
+    for (int r = 0; r < cantidadRutas(); ++r) {
+        if (largo(r) < 2) return false;
+        double costo = distancias != nullptr ? costoDe(r) : costos[r];
+        if (fabs(costo - costos[r]) > tolerancia * (1.0 + costo)) return false;
+        total += costo;
+
+        int carga = 0;
+        for (int p = 1; p + 1 < largo(r); ++p) {
+            int c = nodo(r, p);
+            if (rutaDe[c] != r || posicion[c] != p) return false;
+            if (predecesor[c] != nodo(r, p - 1) || sucesor[c] != nodo(r, p + 1)) return false;
+            if (enlazada()) {
+                carga += q(c);
+                if (cargaHasta(r, p) != carga) return false;
+            }
+        }
+        if (enlazada() && (carga != demandas[r] || carga > capacidad)) return false;
+    }
+    return fabs(total - costoTotal) <= tolerancia * (1.0 + total);
+}
 
-double Solution::calcularCostoRuta(const std::vector<int>& ruta, const std::vector<std::vector<double>>& distancias) const {
+
+double Solution::calcularCostoRuta(const std::vector<int>& ruta, const DistanceMatrix& distancias) const {
     double total = 0.0;
-    for (size_t i = 0; i < ruta.size() - 1; ++i) {
+    for (size_t i = 0; i + 1 < ruta.size(); ++i) {
         int from = ruta[i];
         int to = ruta[i + 1];
-        total += distancias[from][to];
+        total += distancias(from, to);
     }
     return total;
 }
 
 void Solution::imprimir() const {
     std::cout << "Rutas:" << std::endl;
-    for (size_t i = 0; i < rutas.size(); ++i) {
-    std::cout << "Ruta " << i + 1 << ": ";
-    for (int nodo : rutas[i]) {
-        std::cout << nodo << " ";
+    for (int r = 0; r < cantidadRutas(); ++r) {
+        std::cout << "Ruta " << r + 1 << ": ";
+        for (int nodo : ruta(r)) {
+            std::cout << nodo << " ";
+        }
+        std::cout << "| SUMD = " << demandas[r] << std::endl;
     }
-    std::cout << "| SUMD = " << demandas[i] << std::endl;
-}
 
     std::cout << "Costo total: " << costoTotal << std::endl;
 }
 
-const std::vector<std::vector<int>>& Solution::getRutas() const {
+bool Solution::operator==(const Solution& otra) const {
+    return inicio == otra.inicio && nodos == otra.nodos;
+}
+
+std::vector<std::vector<int>> Solution::getRutas() const {
+    std::vector<std::vector<int>> rutas;
+    rutas.reserve(cantidadRutas());
+    for (int r = 0; r < cantidadRutas(); ++r) rutas.push_back(ruta(r).aVector());
     return rutas;
 }
 
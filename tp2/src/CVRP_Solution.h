@@ -3,28 +3,176 @@
 
 #include <vector>
 #include <iostream>
+#include "DistanceMatrix.h"
 
+// Vista de solo lectura de una ruta dentro del buffer de la solución (como un
+// std::span): válida mientras la solución no se modifique
+struct VistaRuta {
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return static_cast<int>(last - first); }
+    int operator[](int i) const { return first[i]; }
+    int front() const { return *first; }
+    int back() const { return *(last - 1); }
+    std::vector<int> aVector() const { return std::vector<int>(first, last); }
+};
+
+// Movimientos sobre una Solution enlazada a su instancia (ver enlazar()). Se
+// evalúan sin modificarla (factible, delta), se aplican y se deshacen.
+// Las posiciones cuentan el depósito inicial como 0.
+
+// Intercambia dos clientes (de la misma ruta o de rutas distintas)
+struct MovSwap {
+    int a;
+    int b;
+};
+
+// Saca al cliente de su ruta y lo deja en la posición `posicion` de `ruta`
+// (contada después de sacarlo). aplicar() anota de dónde salió para deshacer.
+struct MovRelocate {
+    int cliente;
+    int ruta;
+    int posicion;
+    int ruta_origen = -1;
+    int posicion_origen = -1;
+};
+
+// Invierte las posiciones i..j (1 <= i < j) de una ruta
+struct Mov2opt {
+    int ruta;
+    int i;
+    int j;
+};
+
+// Corta ruta1 después de la posición i y ruta2 después de la j, e
+// intercambia las colas. Aplicarlo dos veces deja todo como estaba.
+struct Mov2optEstrella {
+    int ruta1;
+    int i;
+    int ruta2;
+    int j;
+};
+
+// Todas las rutas viven en un único buffer contiguo de nodos, una detrás de
+// otra (cada una empieza y termina en el depósito), con el comienzo de cada
+// ruta en `inicio`. Por ruta se guardan costo y carga; por cliente, su ruta,
+// su posición y sus vecinos en la ruta, así que ubicar un cliente es O(1).
+// Solo se puede mover: las copias son explícitas con clone().
 class Solution {
 private:
-    std::vector<std::vector<int>> rutas; // Cada ruta empieza y termina en el depósito
+    std::vector<int> nodos;          // rutas concatenadas
+    std::vector<int> inicio;         // ruta r = nodos[inicio[r], inicio[r + 1])
+    std::vector<double> costos;      // costo de cada ruta
+    std::vector<int> demandas;       // suma de demandas por ruta
     double costoTotal; // Se va actualizando a medida que se agregan rutas
-    std::vector<int> demandas;  // suma de demandas por ruta
 
+    // Por id de cliente (-1 si no está en ninguna ruta)
+    std::vector<int> rutaDe;
+    std::vector<int> posicion;       // índice dentro de su ruta (el depósito es 0)
+    std::vector<int> predecesor;
+    std::vector<int> sucesor;
+
+    // Instancia enlazada (para los movimientos) y, alineada con `nodos`, la
+    // demanda acumulada desde el principio de cada ruta
+    const DistanceMatrix* distancias {nullptr};
+    const std::vector<int>* demandaCliente {nullptr};
+    int capacidad {0};
+    std::vector<int> cargaAcum;
+    std::vector<int> auxiliar1, auxiliar2;
+
+    void indexarRuta(int r);
+    // Actualiza ruta, posición y vecinos de las posiciones [desde, hasta] de r
+    void reindexar(int r, int desde, int hasta);
+    void recalcularCargas(int r, int desde);
+    // Reemplaza el contenido de la ruta r, corriendo las siguientes en el buffer
+    void reescribirRuta(int r, const std::vector<int>& nueva);
+    double costoDe(int r) const;
+    int nodo(int r, int p) const { return nodos[inicio[r] + p]; }
+    int largo(int r) const { return inicio[r + 1] - inicio[r]; }
+    double d(int a, int b) const { return (*distancias)(a, b); }
+    int q(int c) const { return (*demandaCliente)[c]; }
 
 public:
     Solution();
 
+    Solution(const Solution&) = delete;
+    Solution& operator=(const Solution&) = delete;
+    Solution(Solution&&) noexcept = default;
+    Solution& operator=(Solution&&) noexcept = default;
+
+    // Copia explícita
+    Solution clone() const;
+
+    // Enlaza la instancia (distancias, demandas por id y capacidad) para poder
+    // usar los movimientos. Tienen que durar más que la solución.
+    void enlazar(const DistanceMatrix& distancias, const std::vector<int>& demandas, int capacidad);
+    bool enlazada() const { return demandaCliente != nullptr; }
+
+    // Movimientos. delta() es la variación del costo total si se aplicara, en
+    // O(1); factible() mira la capacidad, también en O(1). aplicar() actualiza
+    // costo, carga y posiciones; deshacer() vuelve al estado anterior.
+    bool factible(const MovSwap& m) const;
+    double delta(const MovSwap& m) const;
+    void aplicar(MovSwap& m);
+    void deshacer(const MovSwap& m);
+
+    bool factible(const MovRelocate& m) const;
+    double delta(const MovRelocate& m) const;
+    void aplicar(MovRelocate& m);
+    void deshacer(const MovRelocate& m);
+
+    bool factible(const Mov2opt& m) const;
+    double delta(const Mov2opt& m) const;
+    void aplicar(Mov2opt& m);
+    void deshacer(const Mov2opt& m);
+
+    bool factible(const Mov2optEstrella& m) const;
+    double delta(const Mov2optEstrella& m) const;
+    void aplicar(Mov2optEstrella& m);
+    void deshacer(const Mov2optEstrella& m);
+
+    // Recalcula todo desde cero y lo compara con lo cacheado (costos con
+    // tolerancia relativa). Sin NDEBUG, los movimientos lo verifican solos.
+    bool verificar(double tolerancia = 1e-6) const;
+
+    // Reserva lugar para `cantidadNodos` nodos (depósitos incluidos) y `cantidadRutas` rutas
+    void reservar(int cantidadNodos, int cantidadRutas);
+    // Vacía la solución sin liberar memoria, para reusarla
+    void limpiar();
+
     // Agrega una ruta a la solución y suma su costo al total
-    void agregarRuta(const std::vector<int>& ruta, const std::vector<std::vector<double>>& distancias, int suma_demanda);
+    void agregarRuta(const std::vector<int>& ruta, const DistanceMatrix& distancias, int suma_demanda);
 
     // Calcula el costo de una sola ruta
-    double calcularCostoRuta(const std::vector<int>& ruta, const std::vector<std::vector<double>>& distancias) const;
+    double calcularCostoRuta(const std::vector<int>& ruta, const DistanceMatrix& distancias) const;
 
     // Imprime todas las rutas y el costo total
     void imprimir() const;
 
+    // Misma secuencia de rutas (compara los buffers, sin copiar nada)
+    bool operator==(const Solution& otra) const;
+    bool operator!=(const Solution& otra) const { return !(*this == otra); }
+
     // Getters
-    const std::vector<std::vector<int>>& getRutas() const;
+    int cantidadRutas() const { return static_cast<int>(costos.size()); }
+    VistaRuta ruta(int r) const { return {nodos.data() + inicio[r], nodos.data() + inicio[r + 1]}; }
+    double costoRuta(int r) const { return costos[r]; }
+    int cargaRuta(int r) const { return demandas[r]; }
+    // Cantidad de clientes de la ruta (sin los depósitos)
+    int tamanioRuta(int r) const { return inicio[r + 1] - inicio[r] - 2; }
+    // Demanda de las posiciones 0..p de la ruta r (requiere enlazar())
+    int cargaHasta(int r, int p) const { return cargaAcum[inicio[r] + p]; }
+
+    bool contiene(int cliente) const { return cliente < static_cast<int>(rutaDe.size()) && rutaDe[cliente] >= 0; }
+    int rutaDeCliente(int cliente) const { return rutaDe[cliente]; }
+    int posicionDeCliente(int cliente) const { return posicion[cliente]; }
+    int anterior(int cliente) const { return predecesor[cliente]; }
+    int siguiente(int cliente) const { return sucesor[cliente]; }
+
+    // Copia de las rutas como vectores (para exportarlas o pasarlas a código viejo)
+    std::vector<std::vector<int>> getRutas() const;
     double getCostoTotal() const;
 };
 
@@ -0,0 +1,240 @@
+#include "DistanceMatrix.h"
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+
+namespace {
+constexpr std::size_t kDoublesPerLine = DistanceMatrix::kAlignment / sizeof(double);
+
+std::size_t roundUpToLine(std::size_t count) {
+    return (count + kDoublesPerLine - 1) / kDoublesPerLine * kDoublesPerLine;
+}
+
+// Small per-thread LRU cache of materialized rows for the non-Full storages.
+struct RowCache {
+    struct Slot {
+        std::uint64_t uid {0};
+        std::uint64_t version {0};
+        int row {-1};
+        std::uint64_t lastUse {0};
+        std::vector<double> values;
+    };
+
+    Slot slots[DistanceMatrix::kCachedRows];
+    std::uint64_t clock {0};
+
+    // Returns the slot holding (uid, version, row), or the one to overwrite.
+    Slot& find(std::uint64_t uid, std::uint64_t version, int row, bool& hit) {
+        Slot* victim = &slots[0];
+        for (Slot& slot : slots) {
+            if (slot.uid == uid && slot.version == version && slot.row == row) {
+                slot.lastUse = ++clock;
+                hit = true;
+                return slot;
+            }
+            if (slot.lastUse < victim->lastUse) victim = &slot;
+        }
+        hit = false;
+        victim->uid = uid;
+        victim->version = version;
+        victim->row = row;
+        victim->lastUse = ++clock;
+        return *victim;
+    }
+};
+
+thread_local RowCache rowCache;
+}
+
+void DistanceMatrix::AlignedDeleter::operator()(double* p) const {
+    ::operator delete[](p, std::align_val_t(kAlignment));
+}
+
+std::uint64_t DistanceMatrix::nextUid() {
+    static std::atomic<std::uint64_t> counter {0};
+    return ++counter;
+}
+
+DistanceMatrix::DistanceMatrix() = default;
+
+DistanceMatrix::DistanceMatrix(int size, Storage storage) : n(size), storage(storage), uid(nextUid()) {
+    if (size < 0) {
+        throw std::invalid_argument("Error: DistanceMatrix size must be non-negative");
+    }
+    if (storage == Storage::OnTheFly) {
+        throw std::invalid_argument("Error: OnTheFly storage needs coordinates");
+    }
+    allocate();
+}
+
+DistanceMatrix::DistanceMatrix(std::vector<double> xs, std::vector<double> ys)
+    : n(static_cast<int>(xs.size())), storage(Storage::OnTheFly),
+      xs(std::move(xs)), ys(std::move(ys)), uid(nextUid()) {
+    if (this->xs.size() != this->ys.size()) {
+        throw std::invalid_argument("Error: coordinate arrays differ in size");
+    }
+}
+
+DistanceMatrix::DistanceMatrix(const double* external, int size, Storage storage, std::size_t stride)
+    : values(external), n(size), stride(stride), storage(storage), uid(nextUid()) {
+    if (storage == Storage::OnTheFly) {
+        throw std::invalid_argument("Error: OnTheFly storage needs coordinates");
+    }
+    std::size_t count = static_cast<std::size_t>(size);
+    capacity = storage == Storage::Full ? stride * count : roundUpToLine(count * (count + 1) / 2);
+}
+
+DistanceMatrix::DistanceMatrix(const DistanceMatrix& other)
+    : n(other.n), stride(other.stride), capacity(other.capacity), storage(other.storage),
+      xs(other.xs), ys(other.ys), uid(nextUid()) {
+    if (storage == Storage::OnTheFly) return;
+    allocate();
+    std::copy(other.values, other.values + capacity, data.get());
+}
+
+DistanceMatrix& DistanceMatrix::operator=(const DistanceMatrix& other) {
+    if (this != &other) {
+        DistanceMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+DistanceMatrix::DistanceMatrix(DistanceMatrix&& other) noexcept
+    : data(std::move(other.data)), values(other.values), n(other.n), stride(other.stride),
+      capacity(other.capacity), storage(other.storage),
+      xs(std::move(other.xs)), ys(std::move(other.ys)),
+      uid(other.uid), version(other.version) {
+    other.values = nullptr;
+    other.n = 0;
+    other.stride = 0;
+    other.capacity = 0;
+    other.uid = 0;
+}
+
+DistanceMatrix& DistanceMatrix::operator=(DistanceMatrix&& other) noexcept {
+    data = std::move(other.data);
+    values = other.values;
+    n = other.n;
+    stride = other.stride;
+    capacity = other.capacity;
+    storage = other.storage;
+    xs = std::move(other.xs);
+    ys = std::move(other.ys);
+    uid = other.uid;
+    version = other.version;
+    other.values = nullptr;
+    other.n = 0;
+    other.stride = 0;
+    other.capacity = 0;
+    other.uid = 0;
+    return *this;
+}
+
+// Allocates a zero-filled, cache-line aligned buffer for the current size and storage.
+void DistanceMatrix::allocate() {
+    std::size_t count = static_cast<std::size_t>(n);
+    if (storage == Storage::Full) {
+        stride = roundUpToLine(count);
+        capacity = stride * count;
+    } else {
+        stride = 0;
+        capacity = roundUpToLine(count * (count + 1) / 2);
+    }
+
+    data.reset();
+    values = nullptr;
+    if (capacity == 0) return;
+    data.reset(static_cast<double*>(::operator new[](capacity * sizeof(double), std::align_val_t(kAlignment))));
+    std::fill(data.get(), data.get() + capacity, 0.0);
+    values = data.get();
+}
+
+void DistanceMatrix::set(int i, int j, double value) {
+    if (isView()) {
+        throw std::logic_error("Error: cannot modify a DistanceMatrix view");
+    }
+    if (storage == Storage::Full) {
+        data[static_cast<std::size_t>(i) * stride + j] = value;
+    } else if (storage == Storage::PackedSymmetric) {
+        data[packedIndex(i, j)] = value;
+        ++version;
+    } else {
+        throw std::logic_error("Error: OnTheFly distances are read-only");
+    }
+}
+
+void DistanceMatrix::fillEuclidean(const std::vector<double>& x, const std::vector<double>& y, int first) {
+    if (storage == Storage::OnTheFly || isView()) {
+        throw std::logic_error("Error: OnTheFly distances and views are read-only");
+    }
+    if (x.size() < static_cast<std::size_t>(n) || y.size() < static_cast<std::size_t>(n)) {
+        throw std::invalid_argument("Error: not enough coordinates for the matrix");
+    }
+
+    for (int i = first; i < n; ++i) {
+        const double xi = x[i];
+        const double yi = y[i];
+        double* out = storage == Storage::Full
+            ? data.get() + static_cast<std::size_t>(i) * stride
+            : data.get() + packedIndex(i, 0);
+        // Lower triangle (j <= i) is contiguous in both storages
+        for (int j = first; j <= i; ++j) {
+            double dx = xi - x[j];
+            double dy = yi - y[j];
+            out[j] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    if (storage == Storage::Full) {
+        // Mirror the lower triangle into the upper one
+        for (int i = first; i < n; ++i) {
+            double* out = data.get() + static_cast<std::size_t>(i) * stride;
+            for (int j = i + 1; j < n; ++j) {
+                out[j] = data[static_cast<std::size_t>(j) * stride + i];
+            }
+        }
+    }
+    ++version;
+}
+
+const double* DistanceMatrix::row(int i) const {
+    if (storage == Storage::Full) {
+        return values + static_cast<std::size_t>(i) * stride;
+    }
+
+    bool hit = false;
+    RowCache::Slot& slot = rowCache.find(uid, version, i, hit);
+    if (!hit) {
+        slot.values.resize(static_cast<std::size_t>(n));
+        double* out = slot.values.data();
+        if (storage == Storage::PackedSymmetric) {
+            for (int j = 0; j < n; ++j) out[j] = values[packedIndex(i, j)];
+        } else {
+            const double xi = xs[i];
+            const double yi = ys[i];
+            for (int j = 0; j < n; ++j) {
+                double dx = xi - xs[j];
+                double dy = yi - ys[j];
+                out[j] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+    }
+    return slot.values.data();
+}
+
+// --- Getter Implementations ---
+
+int DistanceMatrix::size() const { return n; }
+bool DistanceMatrix::empty() const { return n == 0; }
+std::size_t DistanceMatrix::getStride() const { return stride; }
+DistanceMatrix::Storage DistanceMatrix::getStorage() const { return storage; }
+
+const double* DistanceMatrix::buffer() const { return values; }
+bool DistanceMatrix::isView() const { return values != nullptr && !data; }
+
+std::size_t DistanceMatrix::bytes() const {
+    if (storage == Storage::OnTheFly) return (xs.size() + ys.size()) * sizeof(double);
+    return capacity * sizeof(double);
+}
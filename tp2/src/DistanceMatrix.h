@@ -0,0 +1,113 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Square distance matrix indexed by node id.
+//
+// Full storage is row-major in a single contiguous buffer with every row padded
+// to a multiple of 8 doubles (one 64-byte cache line), so rows start aligned and
+// can be scanned with SIMD.
+// PackedSymmetric storage keeps only the lower triangle (i >= j), halving the
+// memory at the cost of a min/max per lookup.
+// OnTheFly storage keeps no matrix at all: it holds the coordinates as SoA arrays
+// and computes the Euclidean distance on every lookup, so it needs O(n) memory
+// and can back instances whose n² matrix would not fit in RAM.
+class DistanceMatrix {
+public:
+    enum class Storage { Full, PackedSymmetric, OnTheFly };
+
+    // Alignment (in bytes) of the buffer and of every row in Full storage
+    static constexpr std::size_t kAlignment = 64;
+
+    // Number of rows each thread keeps in its row() cache (non-Full storage)
+    static constexpr int kCachedRows = 8;
+
+    DistanceMatrix();
+    // Zero-filled matrix for Full or PackedSymmetric storage
+    explicit DistanceMatrix(int size, Storage storage = Storage::Full);
+    // OnTheFly matrix over the given coordinates (indexed by node id)
+    DistanceMatrix(std::vector<double> xs, std::vector<double> ys);
+    // Read-only view over an external buffer laid out like buffer() of a matrix
+    // with the same size, storage and stride (e.g. a memory-mapped cache file).
+    // The buffer must outlive the matrix; copies of a view own their data.
+    DistanceMatrix(const double* external, int size, Storage storage, std::size_t stride);
+
+    DistanceMatrix(const DistanceMatrix& other);
+    DistanceMatrix& operator=(const DistanceMatrix& other);
+    DistanceMatrix(DistanceMatrix&& other) noexcept;
+    DistanceMatrix& operator=(DistanceMatrix&& other) noexcept;
+
+    // Distance between nodes i and j. In Full storage this is one indexed load.
+    double operator()(int i, int j) const {
+        if (storage == Storage::Full) {
+            return values[static_cast<std::size_t>(i) * stride + j];
+        }
+        if (storage == Storage::PackedSymmetric) {
+            return values[packedIndex(i, j)];
+        }
+        double dx = xs[i] - xs[j];
+        double dy = ys[i] - ys[j];
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    // Writes d(i, j). In PackedSymmetric storage this also defines d(j, i).
+    // Not available in OnTheFly storage or on views.
+    void set(int i, int j, double value);
+
+    // Fills a Full or PackedSymmetric matrix with the Euclidean distances
+    // between the given coordinates (indexed by node id, size() entries each).
+    // Rows and columns of ids below `first` are left at zero.
+    void fillEuclidean(const std::vector<double>& x, const std::vector<double>& y, int first = 0);
+
+    // Pointer to the n distances from node i. In Full storage it points into the
+    // (aligned) buffer; otherwise the row is materialized in a small per-thread
+    // cache and stays valid until kCachedRows other rows are requested on the
+    // same thread. Meant for loops that scan d(i, *) for a fixed i.
+    const double* row(int i) const;
+
+    // --- Getter methods ---
+
+    int size() const;
+    bool empty() const;
+    std::size_t getStride() const;
+    Storage getStorage() const;
+    std::size_t bytes() const;
+    // Raw buffer (bytes() long) of a Full or PackedSymmetric matrix
+    const double* buffer() const;
+    bool isView() const;
+
+private:
+    struct AlignedDeleter {
+        void operator()(double* p) const;
+    };
+
+    std::unique_ptr<double[], AlignedDeleter> data; // Owned buffer (empty for views)
+    const double* values {nullptr};                // Buffer read by lookups
+    int n {0};
+    std::size_t stride {0};   // Row length in doubles (Full storage only)
+    std::size_t capacity {0}; // Number of doubles in the buffer
+    Storage storage {Storage::Full};
+    std::vector<double> xs;   // Coordinates (OnTheFly storage only)
+    std::vector<double> ys;
+
+    // Identify this matrix's contents in the per-thread row cache. set() bumps
+    // the version so stale rows are never served.
+    std::uint64_t uid {0};
+    std::uint64_t version {0};
+
+    static std::size_t packedIndex(int i, int j) {
+        std::size_t a = static_cast<std::size_t>(i > j ? i : j);
+        std::size_t b = static_cast<std::size_t>(i > j ? j : i);
+        return a * (a + 1) / 2 + b;
+    }
+
+    static std::uint64_t nextUid();
+    void allocate();
+};
+
+#endif // DISTANCE_MATRIX_H
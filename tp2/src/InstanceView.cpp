@@ -0,0 +1,106 @@
+#include "InstanceView.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include "VRPLIBReader.h"
+
+InstanceView::InstanceView(const VRPLIBReader& reader)
+    : capacity(reader.getCapacity()), distances(&reader.getDistanceMatrix()),
+      planar(reader.isPlanarEuclidean()), uid(nextUid()) {
+    const std::vector<Node>& nodes = reader.getNodes();
+    ids.reserve(nodes.size());
+    xs.reserve(nodes.size());
+    ys.reserve(nodes.size());
+    demands.reserve(nodes.size());
+    for (const Node& node : nodes) {
+        ids.push_back(node.id);
+        xs.push_back(node.x);
+        ys.push_back(node.y);
+        demands.push_back(node.demanda);
+    }
+
+    // Depot to the front, swapping places with the first node
+    auto depot = std::find(ids.begin(), ids.end(), reader.getDepotId());
+    if (depot == ids.end()) {
+        throw std::runtime_error("Error: depot is not one of the instance nodes");
+    }
+    std::size_t d = depot - ids.begin();
+    std::swap(ids[0], ids[d]);
+    std::swap(xs[0], xs[d]);
+    std::swap(ys[0], ys[d]);
+    std::swap(demands[0], demands[d]);
+    buildIndex();
+}
+
+InstanceView::InstanceView(const std::vector<Cliente>& clientes, int capacity,
+                           const DistanceMatrix* distances)
+    : capacity(capacity), distances(distances), uid(nextUid()) {
+    if (clientes.empty()) {
+        throw std::invalid_argument("Error: an instance needs at least the depot");
+    }
+    ids.reserve(clientes.size());
+    xs.reserve(clientes.size());
+    ys.reserve(clientes.size());
+    demands.reserve(clientes.size());
+    for (const Cliente& c : clientes) {
+        ids.push_back(c.id);
+        xs.push_back(c.x);
+        ys.push_back(c.y);
+        demands.push_back(c.demanda);
+    }
+    buildIndex();
+}
+
+std::uint64_t InstanceView::nextUid() {
+    static std::atomic<std::uint64_t> counter {0};
+    return ++counter;
+}
+
+void InstanceView::buildIndex() {
+    int maxId = ids.empty() ? 0 : *std::max_element(ids.begin(), ids.end());
+    index.assign(static_cast<std::size_t>(maxId) + 1, -1);
+    for (int i = 0; i < size(); ++i) {
+        if (ids[i] < 0) {
+            throw std::invalid_argument("Error: node ids must be non-negative");
+        }
+        index[ids[i]] = i;
+    }
+}
+
+const DistanceMatrix& InstanceView::getDistanceMatrix() const {
+    if (distances == nullptr) {
+        throw std::logic_error("Error: this instance view has no distance matrix");
+    }
+    return *distances;
+}
+
+std::vector<Cliente> InstanceView::clientes() const {
+    std::vector<Cliente> result;
+    result.reserve(ids.size());
+    for (int i = 0; i < size(); ++i) result.push_back(cliente(i));
+    return result;
+}
+
+double InstanceView::routeCost(const std::vector<int>& route) const {
+    const DistanceMatrix& d = getDistanceMatrix();
+    double total = 0.0;
+    for (std::size_t i = 0; i + 1 < route.size(); ++i) {
+        total += d(route[i], route[i + 1]);
+    }
+    return total;
+}
+
+double InstanceView::totalCost(const std::vector<std::vector<int>>& routes) const {
+    double total = 0.0;
+    for (const auto& route : routes) total += routeCost(route);
+    return total;
+}
+
+int InstanceView::routeLoad(const std::vector<int>& route) const {
+    int load = 0;
+    for (std::size_t i = 1; i + 1 < route.size(); ++i) {
+        load += demandOfId(route[i]);
+    }
+    return load;
+}
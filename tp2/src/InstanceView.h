@@ -0,0 +1,86 @@
+#ifndef INSTANCE_VIEW_H
+#define INSTANCE_VIEW_H
+
+#include <cstdint>
+#include <vector>
+#include "Cliente.h"
+#include "DistanceMatrix.h"
+
+class VRPLIBReader;
+
+// Dense, index-based view of an instance. The depot is index 0 and the
+// customers follow in file order, except that the node that was first in the
+// file takes the depot's old place (the same order main and grasp used when
+// swapping the depot to the front). Ids and dense indices translate in O(1),
+// and coordinates and demands are SoA arrays indexed by dense index.
+// Routes are still written as node ids, and the distance matrix is still
+// indexed by id, so route costs are plain matrix lookups.
+class InstanceView {
+public:
+    // View over a parsed instance. The reader must outlive the view.
+    explicit InstanceView(const VRPLIBReader& reader);
+    // View over an explicit customer list whose first entry is the depot.
+    // `distances` (indexed by id) may be null for algorithms that only use
+    // coordinates; it must outlive the view and is taken to be the Euclidean
+    // distances between the given coordinates.
+    InstanceView(const std::vector<Cliente>& clientes, int capacity,
+                 const DistanceMatrix* distances = nullptr);
+
+    // Number of nodes, depot included
+    int size() const { return static_cast<int>(ids.size()); }
+    int getCapacity() const { return capacity; }
+    int getDepotId() const { return ids[0]; }
+
+    int idOf(int index) const { return ids[index]; }
+    // Dense index of a node id, or -1 if the id is not a node
+    int indexOf(int id) const {
+        return id >= 0 && id < static_cast<int>(index.size()) ? index[id] : -1;
+    }
+
+    double x(int index) const { return xs[index]; }
+    double y(int index) const { return ys[index]; }
+    int demand(int index) const { return demands[index]; }
+    int demandOfId(int id) const { return demands[index[id]]; }
+
+    const std::vector<int>& getIds() const { return ids; }
+    const std::vector<double>& getXs() const { return xs; }
+    const std::vector<double>& getYs() const { return ys; }
+    const std::vector<int>& getDemands() const { return demands; }
+
+    // Identifies the contents of this view: every constructed view gets a new
+    // one (copies keep it), so caches keyed on a view can tell a different
+    // instance apart even when it lives at the same address
+    std::uint64_t getUid() const { return uid; }
+
+    bool hasDistances() const { return distances != nullptr; }
+    // True if distances are the plane Euclidean distances between the
+    // coordinates, so geometric indexes (SpatialGrid) can prune with them
+    bool isPlanarEuclidean() const { return planar; }
+    // Distance matrix indexed by node id. Throws if the view has none.
+    const DistanceMatrix& getDistanceMatrix() const;
+
+    // Customer at a dense index, as the older vector<Cliente> interfaces expect
+    Cliente cliente(int index) const { return {ids[index], xs[index], ys[index], demands[index]}; }
+    std::vector<Cliente> clientes() const;
+
+    // Costs and loads of routes written as node ids (depot at both ends)
+    double routeCost(const std::vector<int>& route) const;
+    double totalCost(const std::vector<std::vector<int>>& routes) const;
+    int routeLoad(const std::vector<int>& route) const;
+
+private:
+    std::vector<int> ids;        // dense index -> node id
+    std::vector<int> index;      // node id -> dense index (-1 if unused)
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<int> demands;
+    int capacity {0};
+    const DistanceMatrix* distances {nullptr};
+    bool planar {true};
+    std::uint64_t uid {0};
+
+    static std::uint64_t nextUid();
+    void buildIndex();
+};
+
+#endif // INSTANCE_VIEW_H
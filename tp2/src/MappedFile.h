@@ -0,0 +1,45 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on Windows).
+// The contents stay valid for the lifetime of the object; it can be moved but not copied.
+class MappedFile {
+public:
+    // How the contents will be read, passed to the OS as a paging hint
+    enum class Access {
+        Sequential, // One pass front to back (text parsing): aggressive readahead
+        Random      // Scattered lookups (binary cache arrays): no readahead
+    };
+
+    MappedFile() = default;
+    // Maps the file; throws std::runtime_error if it cannot be opened or mapped
+    explicit MappedFile(const std::string& filePath, Access access = Access::Sequential);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // --- Getter methods ---
+
+    const char* data() const;
+    std::size_t size() const;
+    bool isOpen() const;
+
+private:
+    const char* ptr {nullptr};
+    std::size_t length {0};
+    bool open {false};
+#ifdef _WIN32
+    void* fileHandle {nullptr};
+    void* mappingHandle {nullptr};
+#endif
+
+    void release();
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,71 @@
+#include "NeighborIndex.h"
+#include <algorithm>
+#include <utility>
+
+NeighborIndex::NeighborIndex() = default;
+
+NeighborIndex::NeighborIndex(const DistanceMatrix& distances, int k, int depotId, int first)
+    : n(distances.size()) {
+    int customers = n - first - (depotId >= first && depotId < n ? 1 : 0);
+    this->k = std::max(0, std::min(k, customers - 1));
+    owned.assign(static_cast<std::size_t>(n) * this->k, -1);
+    values = owned.data();
+    if (this->k == 0) return;
+
+    std::vector<std::pair<double, int>> candidates;
+    candidates.reserve(n);
+    for (int i = first; i < n; ++i) {
+        const double* row = distances.row(i);
+        candidates.clear();
+        for (int j = first; j < n; ++j) {
+            if (j != i && j != depotId) candidates.emplace_back(row[j], j);
+        }
+        // Ties are broken by id so the lists are deterministic
+        int take = std::min(this->k, static_cast<int>(candidates.size()));
+        std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.end());
+        int* out = owned.data() + static_cast<std::size_t>(i) * this->k;
+        for (int t = 0; t < take; ++t) out[t] = candidates[t].second;
+    }
+}
+
+NeighborIndex::NeighborIndex(const int* external, int size, int k)
+    : values(external), n(size), k(k) {}
+
+NeighborIndex::NeighborIndex(const NeighborIndex& other)
+    : owned(other.values, other.values + static_cast<std::size_t>(other.n) * other.k),
+      n(other.n), k(other.k) {
+    values = owned.data();
+}
+
+NeighborIndex& NeighborIndex::operator=(const NeighborIndex& other) {
+    if (this != &other) {
+        NeighborIndex copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+NeighborIndex::NeighborIndex(NeighborIndex&& other) noexcept {
+    *this = std::move(other);
+}
+
+NeighborIndex& NeighborIndex::operator=(NeighborIndex&& other) noexcept {
+    if (this != &other) {
+        bool view = other.owned.empty();
+        owned = std::move(other.owned);
+        values = view ? other.values : owned.data();
+        n = other.n;
+        k = other.k;
+        other.values = nullptr;
+        other.n = 0;
+        other.k = 0;
+    }
+    return *this;
+}
+
+// --- Getter Implementations ---
+
+int NeighborIndex::size() const { return n; }
+int NeighborIndex::getK() const { return k; }
+bool NeighborIndex::empty() const { return k == 0; }
+const int* NeighborIndex::buffer() const { return values; }
@@ -0,0 +1,56 @@
+#ifndef NEIGHBOR_INDEX_H
+#define NEIGHBOR_INDEX_H
+
+#include <vector>
+#include "DistanceMatrix.h"
+
+// For every node id, the k nearest customers sorted by increasing distance
+// (the depot and the node itself excluded), stored in one contiguous buffer of
+// size() * k ids. Row id starts at id * k. Rows of ids below `first` (the unused
+// id 0 in VRPLIB instances) are filled with -1.
+class NeighborIndex {
+public:
+    // Contiguous range of neighbor ids of one node
+    struct Range {
+        const int* first;
+        const int* last;
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        int size() const { return static_cast<int>(last - first); }
+        int operator[](int i) const { return first[i]; }
+    };
+
+    NeighborIndex();
+    // Builds the lists from a distance matrix. k is clamped to the number of
+    // customers minus one.
+    NeighborIndex(const DistanceMatrix& distances, int k, int depotId, int first = 1);
+    // Read-only view over an external buffer of size * k ids (e.g. a memory-mapped
+    // cache file). The buffer must outlive the index; copies of a view own their data.
+    NeighborIndex(const int* external, int size, int k);
+
+    NeighborIndex(const NeighborIndex& other);
+    NeighborIndex& operator=(const NeighborIndex& other);
+    NeighborIndex(NeighborIndex&& other) noexcept;
+    NeighborIndex& operator=(NeighborIndex&& other) noexcept;
+
+    // Nearest customers of node id, closest first
+    Range neighbors(int id) const {
+        const int* row = values + static_cast<std::size_t>(id) * k;
+        return {row, row + k};
+    }
+
+    // --- Getter methods ---
+
+    int size() const;
+    int getK() const;
+    bool empty() const;
+    const int* buffer() const;
+
+private:
+    std::vector<int> owned;
+    const int* values {nullptr};
+    int n {0};
+    int k {0};
+};
+
+#endif // NEIGHBOR_INDEX_H
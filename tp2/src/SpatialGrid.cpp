@@ -0,0 +1,185 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SpatialGrid::SpatialGrid(const InstanceView& instance) : instance(&instance) {
+    int n = instance.size();
+    cellOf.assign(n, -1);
+    position.assign(n, 0);
+    if (n <= 1) {
+        nx = ny = 1;
+        cellStart.assign(2, 0);
+        alive.assign(1, 0);
+        minDemand.assign(1, std::numeric_limits<int>::max());
+        return;
+    }
+
+    double maxX = instance.x(1), maxY = instance.y(1);
+    minX = maxX;
+    minY = maxY;
+    for (int i = 2; i < n; ++i) {
+        minX = std::min(minX, instance.x(i));
+        maxX = std::max(maxX, instance.x(i));
+        minY = std::min(minY, instance.y(i));
+        maxY = std::max(maxY, instance.y(i));
+    }
+
+    // About two customers per cell
+    double width = maxX - minX, height = maxY - minY;
+    double targetCells = std::max(1.0, (n - 1) / 2.0);
+    double area = width * height;
+    if (area > 0) {
+        cellSize = std::sqrt(area / targetCells);
+    } else {
+        // Collinear (or coincident) customers: cells along the longer side
+        cellSize = std::max(width, height) / targetCells;
+    }
+    if (!(cellSize > 0)) cellSize = 1.0;
+    nx = std::max(1, std::min(static_cast<int>(width / cellSize) + 1, n));
+    ny = std::max(1, std::min(static_cast<int>(height / cellSize) + 1, n));
+
+    int cells = nx * ny;
+    cellStart.assign(cells + 1, 0);
+    for (int i = 1; i < n; ++i) {
+        int gx = std::min(nx - 1, static_cast<int>((instance.x(i) - minX) / cellSize));
+        int gy = std::min(ny - 1, static_cast<int>((instance.y(i) - minY) / cellSize));
+        cellOf[i] = gy * nx + gx;
+        ++cellStart[cellOf[i] + 1];
+    }
+    for (int c = 0; c < cells; ++c) cellStart[c + 1] += cellStart[c];
+
+    items.assign(n - 1, 0);
+    alive.assign(cells, 0);
+    for (int i = 1; i < n; ++i) {
+        int c = cellOf[i];
+        position[i] = cellStart[c] + alive[c]++;
+        items[position[i]] = i;
+    }
+    minDemand.assign(cells, 0);
+    reset();
+}
+
+void SpatialGrid::reset() {
+    int cells = nx * ny;
+    for (int c = 0; c < cells; ++c) {
+        alive[c] = cellStart[c + 1] - cellStart[c];
+        refreshMinDemand(c);
+    }
+    count = static_cast<int>(items.size());
+}
+
+void SpatialGrid::remove(int index) {
+    if (!contains(index)) return;
+    // Swap with the last present customer of the cell
+    int c = cellOf[index];
+    int last = cellStart[c] + --alive[c];
+    int other = items[last];
+    std::swap(items[position[index]], items[last]);
+    position[other] = position[index];
+    position[index] = last;
+    --count;
+    if (instance->demand(index) == minDemand[c]) refreshMinDemand(c);
+}
+
+void SpatialGrid::refreshMinDemand(int cell) {
+    int m = std::numeric_limits<int>::max();
+    for (int p = cellStart[cell]; p < cellStart[cell] + alive[cell]; ++p) {
+        m = std::min(m, instance->demand(items[p]));
+    }
+    minDemand[cell] = m;
+}
+
+template <class Bound, class Scan>
+void SpatialGrid::search(int from, int maxDemand, Bound bound, Scan scan) const {
+    if (count == 0) return;
+    double qx = instance->x(from), qy = instance->y(from);
+    int cx = std::clamp(static_cast<int>(std::floor((qx - minX) / cellSize)), 0, nx - 1);
+    int cy = std::clamp(static_cast<int>(std::floor((qy - minY) / cellSize)), 0, ny - 1);
+    int rings = std::max(std::max(cx, nx - 1 - cx), std::max(cy, ny - 1 - cy));
+
+    // Coordinates only prune: allow for the rounding of the matrix values
+    auto beyond = [&](double d) {
+        double b = bound();
+        return d > b + 1e-9 * (1.0 + b);
+    };
+    auto visit = [&](int gx, int gy) {
+        int c = gy * nx + gx;
+        if (alive[c] == 0 || minDemand[c] > maxDemand) return;
+        double x0 = minX + gx * cellSize, y0 = minY + gy * cellSize;
+        double dx = std::max(0.0, std::max(x0 - qx, qx - (x0 + cellSize)));
+        double dy = std::max(0.0, std::max(y0 - qy, qy - (y0 + cellSize)));
+        if (beyond(std::sqrt(dx * dx + dy * dy))) return;
+        scan(c);
+    };
+
+    for (int r = 0; r <= rings; ++r) {
+        if (r > 0) {
+            // Every cell of ring r lies outside the box of the rings below it;
+            // sides that already reach the grid border do not count
+            double inf = std::numeric_limits<double>::infinity();
+            double left = cx - r + 1 > 0 ? qx - (minX + (cx - r + 1) * cellSize) : inf;
+            double right = cx + r - 1 < nx - 1 ? minX + (cx + r) * cellSize - qx : inf;
+            double down = cy - r + 1 > 0 ? qy - (minY + (cy - r + 1) * cellSize) : inf;
+            double up = cy + r - 1 < ny - 1 ? minY + (cy + r) * cellSize - qy : inf;
+            double gap = std::min(std::min(left, right), std::min(down, up));
+            if (beyond(std::max(0.0, gap))) break;
+        }
+        int x0 = std::max(0, cx - r), x1 = std::min(nx - 1, cx + r);
+        int y0 = std::max(0, cy - r), y1 = std::min(ny - 1, cy + r);
+        for (int gy = y0; gy <= y1; ++gy) {
+            if (gy == cy - r || gy == cy + r) {
+                for (int gx = x0; gx <= x1; ++gx) visit(gx, gy);
+            } else {
+                if (cx - r >= 0) visit(cx - r, gy);
+                if (r > 0 && cx + r < nx) visit(cx + r, gy);
+            }
+        }
+    }
+}
+
+int SpatialGrid::nearest(int from, int maxDemand) const {
+    const std::vector<int>& ids = instance->getIds();
+    const DistanceMatrix& distances = instance->getDistanceMatrix();
+    double best = std::numeric_limits<double>::infinity();
+    int bestIndex = -1;
+    search(from, maxDemand, [&] { return best; }, [&](int c) {
+        for (int p = cellStart[c]; p < cellStart[c] + alive[c]; ++p) {
+            int i = items[p];
+            if (instance->demand(i) > maxDemand) continue;
+            double d = distances(ids[from], ids[i]);
+            if (d < best || (d == best && i < bestIndex)) {
+                best = d;
+                bestIndex = i;
+            }
+        }
+    });
+    return bestIndex;
+}
+
+void SpatialGrid::nearest(int from, int maxDemand, int k, std::vector<std::pair<double, int>>& out) const {
+    const std::vector<int>& ids = instance->getIds();
+    const DistanceMatrix& distances = instance->getDistanceMatrix();
+    out.clear();
+    if (k <= 0) return;
+    // Max-heap of the k best (distance, index) pairs seen so far
+    auto bound = [&] {
+        return static_cast<int>(out.size()) < k ? std::numeric_limits<double>::infinity() : out.front().first;
+    };
+    search(from, maxDemand, bound, [&](int c) {
+        for (int p = cellStart[c]; p < cellStart[c] + alive[c]; ++p) {
+            int i = items[p];
+            if (instance->demand(i) > maxDemand) continue;
+            std::pair<double, int> candidate(distances(ids[from], ids[i]), i);
+            if (static_cast<int>(out.size()) < k) {
+                out.push_back(candidate);
+                std::push_heap(out.begin(), out.end());
+            } else if (candidate < out.front()) {
+                std::pop_heap(out.begin(), out.end());
+                out.back() = candidate;
+                std::push_heap(out.begin(), out.end());
+            }
+        }
+    });
+    std::sort_heap(out.begin(), out.end());
+}
@@ -0,0 +1,60 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <utility>
+#include <vector>
+#include "InstanceView.h"
+
+// Uniform grid over the customers of an InstanceView (dense indices, depot
+// excluded), about two customers per cell. Customers can be removed as they
+// are routed, and queries return the nearest remaining customers whose
+// demand fits in a given free capacity: cells are visited in rings around
+// the query point and skipped when empty, when every customer in them is too
+// heavy (each cell keeps the minimum demand it still holds) or when they are
+// farther than the current k-th best.
+//
+// Candidate distances are read from the instance's distance matrix, so results
+// match a linear scan exactly (ties go to the lower index); the coordinates are
+// only used to prune, which is why the instance must be plane Euclidean.
+class SpatialGrid {
+public:
+    SpatialGrid() = default;
+    // Grid holding every customer. The instance must outlive the grid.
+    explicit SpatialGrid(const InstanceView& instance);
+
+    // Puts every customer back without allocating
+    void reset();
+    void remove(int index);
+    bool contains(int index) const { return position[index] < cellStart[cellOf[index]] + alive[cellOf[index]]; }
+    int remaining() const { return count; }
+
+    // Nearest remaining customer to node `from` (any dense index, the depot
+    // included) with demand <= maxDemand, or -1 if there is none
+    int nearest(int from, int maxDemand) const;
+    // Up to k nearest such customers as (distance, index), closest first.
+    // `out` is cleared and reused, so a caller that keeps it does not allocate.
+    void nearest(int from, int maxDemand, int k, std::vector<std::pair<double, int>>& out) const;
+
+private:
+    const InstanceView* instance {nullptr};
+    double minX {0}, minY {0}, cellSize {1};
+    int nx {0}, ny {0};
+    int count {0};
+    std::vector<int> cellStart;    // customers of cell c: items[cellStart[c], cellStart[c + 1])
+    std::vector<int> alive;        // the first alive[c] of them are still present
+    std::vector<int> minDemand;    // smallest demand among the present ones
+    std::vector<int> items;
+    std::vector<int> cellOf;       // dense index -> cell
+    std::vector<int> position;     // dense index -> position in items
+
+    void refreshMinDemand(int cell);
+
+    // Visits the cells in rings around node `from` until the ring is farther
+    // than bound(); scan(cell) inspects one cell. Distances are looked up one
+    // candidate at a time, never as a whole row, so an OnTheFly matrix only
+    // computes the ones the scan reaches.
+    template <class Bound, class Scan>
+    void search(int from, int maxDemand, Bound bound, Scan scan) const;
+};
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,131 @@
+#include "Trace.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace trace {
+
+namespace detail {
+std::atomic<bool> enabled{false};
+}
+
+namespace {
+
+struct Event {
+    const char* name;
+    std::uint64_t start;
+    std::uint64_t end;
+};
+
+// Written only by its owner thread; `head` counts every event ever recorded
+// and is published with release so flush() sees complete events
+struct ThreadBuffer {
+    int tid = 0;
+    std::vector<Event> events;
+    std::atomic<std::uint64_t> head{0};
+};
+
+const auto epoch = std::chrono::steady_clock::now();
+
+// Guards the registry, the interned names and the settings. Threads take it
+// once, when they record their first event.
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+std::set<std::string> names;
+std::string outputPath;
+std::size_t capacity = 0;  // power of two
+bool flushAtExit = false;
+
+thread_local ThreadBuffer* local = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (local == nullptr) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->tid = static_cast<int>(buffers.size());
+        buffer->events.resize(capacity);
+        local = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+    return *local;
+}
+
+void writeEscaped(std::ostream& out, const char* s) {
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out << '\\';
+        out << *s;
+    }
+}
+
+}  // namespace
+
+void enable(const std::string& path, std::size_t eventsPerThread) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    outputPath = path;
+    if (capacity == 0) {
+        capacity = 1;
+        while (capacity < eventsPerThread) capacity <<= 1;
+    }
+    if (!flushAtExit) {
+        std::atexit(flush);
+        flushAtExit = true;
+    }
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void flush() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (outputPath.empty()) return;
+    std::ofstream out(outputPath);
+    if (!out) {
+        std::fprintf(stderr, "Error: cannot write trace file %s\n", outputPath.c_str());
+        return;
+    }
+
+    std::uint64_t dropped = 0;
+    out << "{\"traceEvents\": [\n";
+    bool first = true;
+    char number[64];
+    for (const auto& buffer : buffers) {
+        out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+            << buffer->tid << ", \"args\": {\"name\": \"thread " << buffer->tid << "\"}}";
+        first = false;
+
+        std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t count = head < capacity ? head : capacity;
+        dropped += head - count;
+        for (std::uint64_t i = head - count; i < head; ++i) {
+            const Event& e = buffer->events[i & (capacity - 1)];
+            out << ",\n{\"name\": \"";
+            writeEscaped(out, e.name);
+            std::snprintf(number, sizeof number, "%.3f, \"dur\": %.3f", e.start / 1000.0,
+                          (e.end - e.start) / 1000.0);
+            out << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid << ", \"ts\": " << number << "}";
+        }
+    }
+    out << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+}
+
+const char* intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return names.insert(name).first->c_str();
+}
+
+std::uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void record(const char* name, std::uint64_t start, std::uint64_t end) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head & (capacity - 1)] = Event{name, start, end};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+}  // namespace trace
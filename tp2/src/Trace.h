@@ -0,0 +1,59 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Timeline of solver phases in Chrome trace format (chrome://tracing,
+// ui.perfetto.dev). Tracing is off by default and a scope then costs a single
+// relaxed atomic load, so scopes can stay in release builds. Once enabled,
+// every thread records complete events into its own fixed-size ring buffer
+// (no locks on the recording path; when a buffer wraps the oldest events are
+// overwritten) and all buffers are written as one JSON file at exit.
+namespace trace {
+
+namespace detail {
+extern std::atomic<bool> enabled;
+}
+
+inline bool enabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+// Starts recording. The file is written at exit, or earlier with flush().
+// Calling it again only changes the output path.
+void enable(const std::string& path, std::size_t eventsPerThread = std::size_t(1) << 16);
+// Writes every buffer to the output file. Threads must not be recording.
+void flush();
+
+// Copy of `name` that lives until exit, for event names built at runtime
+const char* intern(const std::string& name);
+
+// Nanoseconds since the process started (steady clock)
+std::uint64_t now();
+// Records the event [start, end) on the calling thread's buffer. `name` must
+// live until exit (a literal or an intern()ed string).
+void record(const char* name, std::uint64_t start, std::uint64_t end);
+
+// Records its own lifetime as one event
+class Scope {
+public:
+    explicit Scope(const char* name) : name(enabled() ? name : nullptr), start(this->name ? now() : 0) {}
+    ~Scope() {
+        if (name) record(name, start, now());
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name;
+    std::uint64_t start;
+};
+
+}  // namespace trace
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#endif // TRACE_H
@@ -1,99 +1,398 @@
 #include "VRPLIBReader.h"
-#include <fstream>
+#include "MappedFile.h"
 #include <stdexcept>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
-#include <sstream>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
 using namespace std;
 
+namespace {
+
+// Single-pass tokenizer over the mapped file. It never allocates: words and
+// lines are returned as views into the mapping and numbers go through from_chars.
+class Scanner {
+public:
+    Scanner(const char* begin, const char* end) : cur(begin), end(end) {}
+
+    bool atEnd() const { return cur >= end; }
+    char peek() const { return cur < end ? *cur : '\0'; }
+    void advance() { ++cur; }
+
+    // Skips spaces, tabs and carriage returns, stopping at end of line
+    void skipBlanks() {
+        while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == '\r')) ++cur;
+    }
+
+    // Skips any whitespace, including newlines
+    void skipWhitespace() {
+        while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == '\r' || *cur == '\n')) ++cur;
+    }
+
+    // Moves past the next newline
+    void skipLine() {
+        while (cur < end && *cur != '\n') ++cur;
+        if (cur < end) ++cur;
+    }
+
+    // True if the next token starts like a number
+    bool atNumber() const {
+        if (cur >= end) return false;
+        char c = *cur;
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+    }
+
+    // Next word, delimited by whitespace or ':'
+    std::string_view word() {
+        skipBlanks();
+        const char* start = cur;
+        while (cur < end && *cur != ' ' && *cur != '\t' && *cur != '\r' && *cur != '\n' && *cur != ':') ++cur;
+        return std::string_view(start, static_cast<std::size_t>(cur - start));
+    }
+
+    // Remainder of the current line without surrounding blanks
+    std::string_view restOfLine() {
+        skipBlanks();
+        const char* start = cur;
+        while (cur < end && *cur != '\n') ++cur;
+        const char* stop = cur;
+        while (stop > start && (stop[-1] == ' ' || stop[-1] == '\t' || stop[-1] == '\r')) --stop;
+        if (cur < end) ++cur;
+        return std::string_view(start, static_cast<std::size_t>(stop - start));
+    }
+
+    // Skips an optional ':' separator after a keyword
+    void skipColon() {
+        skipBlanks();
+        if (peek() == ':') ++cur;
+    }
+
+    bool readDouble(double& value) {
+        skipWhitespace();
+        if (cur < end && *cur == '+') ++cur;
+        auto result = std::from_chars(cur, end, value);
+        if (result.ec != std::errc()) return false;
+        cur = result.ptr;
+        return true;
+    }
+
+    bool readInt(int& value) {
+        skipWhitespace();
+        if (cur < end && *cur == '+') ++cur;
+        const char* start = cur;
+        auto result = std::from_chars(cur, end, value);
+        if (result.ec != std::errc()) return false;
+        cur = result.ptr;
+        if (cur < end && (*cur == '.' || *cur == 'e' || *cur == 'E')) {
+            // Written as a real number (e.g. "10.0"): reparse and round
+            double real;
+            auto again = std::from_chars(start, end, real);
+            if (again.ec != std::errc()) return false;
+            cur = again.ptr;
+            value = static_cast<int>(std::lround(real));
+        }
+        return true;
+    }
+
+private:
+    const char* cur;
+    const char* end;
+};
+
+enum class Keyword {
+    Unknown, Name, Dimension, Capacity, Vehicles, EdgeWeightType, EdgeWeightFormat,
+    NodeCoordType, NodeCoordSection, DemandSection, DepotSection, EdgeWeightSection, Eof
+};
+
+Keyword classify(std::string_view key) {
+    if (key == "NAME") return Keyword::Name;
+    if (key == "DIMENSION") return Keyword::Dimension;
+    if (key == "CAPACITY") return Keyword::Capacity;
+    if (key == "VEHICLES") return Keyword::Vehicles;
+    if (key == "EDGE_WEIGHT_TYPE") return Keyword::EdgeWeightType;
+    if (key == "EDGE_WEIGHT_FORMAT") return Keyword::EdgeWeightFormat;
+    if (key == "NODE_COORD_TYPE") return Keyword::NodeCoordType;
+    if (key == "NODE_COORD_SECTION") return Keyword::NodeCoordSection;
+    if (key == "DEMAND_SECTION") return Keyword::DemandSection;
+    if (key == "DEPOT_SECTION") return Keyword::DepotSection;
+    if (key == "EDGE_WEIGHT_SECTION") return Keyword::EdgeWeightSection;
+    if (key == "EOF") return Keyword::Eof;
+    return Keyword::Unknown;
+}
+
+// --- Binary instance format (.vrpbin) ---
+//
+// A fixed header followed by arrays at 64-byte aligned offsets, in native byte
+// order: xs and ys (dimension + 1 doubles), demands (dimension + 1 int32), the
+// distance matrix buffer exactly as DistanceMatrix::buffer() lays it out, and the
+// neighbor lists ((dimension + 1) * numNeighbors int32). Loading maps the file and
+// points the matrix and the neighbor lists at it without parsing or copying.
+// Bump kBinaryVersion whenever the layout changes.
+
+constexpr char kBinaryMagic[8] = {'V', 'R', 'P', 'B', 'I', 'N', 0, 0};
+constexpr std::uint32_t kBinaryVersion = 1;
+constexpr std::uint32_t kEndianTag = 0x01020304;
+constexpr std::int32_t kNoMatrix = -1;
+
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::uint64_t sourceBytes;    // Size and modification time of the text file,
+    std::int64_t sourceTime;      // used to detect stale caches
+    std::int32_t dimension;
+    std::int32_t capacity;
+    std::int32_t numVehicles;
+    std::int32_t depotId;
+    std::int32_t numNeighbors;
+    std::int32_t matrixStorage;   // DistanceMatrix::Storage, or kNoMatrix
+    std::int32_t canComputeOnTheFly;
+    std::int32_t reserved;
+    std::uint64_t stride;
+    std::uint64_t nameOffset, nameBytes;
+    std::uint64_t xsOffset, ysOffset, demandsOffset;
+    std::uint64_t matrixOffset, matrixBytes;
+    std::uint64_t neighborsOffset, neighborsBytes;
+    std::uint64_t totalBytes;
+};
+
+std::uint64_t alignOffset(std::uint64_t offset) {
+    return (offset + DistanceMatrix::kAlignment - 1) / DistanceMatrix::kAlignment * DistanceMatrix::kAlignment;
+}
+
+// Suffix for the cache's temporary file, unique across processes (pid) and
+// across readers of the same process (counter), so concurrent writers of the
+// same instance never share a half-written file
+std::string temporarySuffix() {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    return ".tmp" + std::to_string(pid) + "." + std::to_string(counter.fetch_add(1));
+}
+
+bool endsWith(const std::string& text, std::string_view suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}
+
 // Constructor: Initializes the reader and starts the parsing process.
-VRPLIBReader::VRPLIBReader(const std::string& filePath) {
+VRPLIBReader::VRPLIBReader(const std::string& filePath, const ReaderOptions& options) {
+    if (endsWith(filePath, ".vrpbin")) {
+        if (!loadBinary(filePath, nullptr, options)) {
+            throw std::runtime_error("Error: invalid binary instance " + filePath);
+        }
+        return;
+    }
+
+    // A cache hit skips parsing and every O(n²) computation
+    std::string cachePath = filePath + ".vrpbin";
+    SourceStamp stamp;
+    bool canCache = false;
+    if (options.useBinaryCache) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(filePath, ec);
+        auto time = std::filesystem::last_write_time(filePath, ec);
+        if (!ec) {
+            stamp.bytes = size;
+            stamp.time = static_cast<std::int64_t>(time.time_since_epoch().count());
+            canCache = true;
+            if (loadBinary(cachePath, &stamp, options)) return;
+        }
+    }
+
     parse(filePath);
+
+    // After parsing all data, compute the distance matrix.
+    computeDistanceMatrix(options);
+    neighborIndex = NeighborIndex(distanceMatrix, options.numNeighbors, depotId);
+
+    if (canCache) {
+        writeBinary(cachePath, stamp);
+    }
 }
 
-// Main parsing method
+// Main parsing method: maps the file and scans it once, filling the SoA arrays directly.
 void VRPLIBReader::parse(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Error: Could not open file " + filePath);
-    }
-
-    std::string line;
-    std::string current_section;
-
-    while (getline(file, line)) {
-        std::istringstream iss(line);
-        std::string keyword;
-        iss >> keyword;
-
-        if (keyword == "NAME") {
-            iss.ignore(2); // Ignore the space and ':'
-            std::getline(iss, name);
-        } else if (keyword == "DIMENSION") {
-            iss.ignore(2);
-            iss >> dimension;
-        } else if (keyword == "CAPACITY") {
-            iss.ignore(2);
-            iss >> capacity;
-        } else if (keyword == "VEHICLES") { // Optional tag
-            iss.ignore(2);
-            iss >> numVehicles;
-        } else if (keyword == "NODE_COORD_SECTION") {
-            current_section = "NODE_COORD_SECTION";
-            nodes.reserve(dimension);
-        } else if (keyword == "DEMAND_SECTION") {
-            current_section = "DEMAND_SECTION";
-            demands.resize(dimension + 1, 0); // Nodes are 1-indexed
-        } else if (keyword == "DEPOT_SECTION") {
-            current_section = "DEPOT_SECTION";
-        } else if (keyword == "EOF") {
-            break;
-        } else if (!keyword.empty() && std::isdigit(keyword[0])) {
-            // Data lines start with a number (the node ID)
-            std::istringstream data_line_stream(line);
-            if (current_section == "NODE_COORD_SECTION") {
+    MappedFile file(filePath);
+    fileBytes = file.size();
+    Scanner scanner(file.data(), file.data() + file.size());
+
+    enum class Section { None, NodeCoord, Demand, Depot, EdgeWeight, Skip };
+    Section section = Section::None;
+    bool threeD = false;
+    bool hasCoords = false;
+
+    auto requireDimension = [&](std::string_view what) {
+        if (dimension <= 0) {
+            throw std::runtime_error("Error: " + std::string(what) + " before DIMENSION in " + filePath);
+        }
+    };
+    auto badData = [&](std::string_view what) {
+        return std::runtime_error("Error: malformed " + std::string(what) + " in " + filePath);
+    };
+
+    bool reachedEof = false;
+    while (!reachedEof) {
+        scanner.skipWhitespace();
+        if (scanner.atEnd()) break;
+
+        // Data lines start with a number (the node ID, or a matrix entry)
+        if (section != Section::None && scanner.atNumber()) {
+            if (section == Section::NodeCoord) {
                 int id;
-                double x, y;
-                data_line_stream >> id >> x >> y;
-                nodes.push_back({id, x, y});
-            } else if (current_section == "DEMAND_SECTION") {
+                double x, y, z = 0.0;
+                if (!scanner.readInt(id) || !scanner.readDouble(x) || !scanner.readDouble(y) ||
+                    (threeD && !scanner.readDouble(z))) {
+                    throw badData("NODE_COORD_SECTION");
+                }
+                if (id >= 1 && id <= dimension) {
+                    xs[id] = x;
+                    ys[id] = y;
+                    if (threeD) zs[id] = z;
+                }
+            } else if (section == Section::Demand) {
                 int id, demand;
-                data_line_stream >> id >> demand;
+                if (!scanner.readInt(id) || !scanner.readInt(demand)) throw badData("DEMAND_SECTION");
                 if (id >= 1 && id <= dimension) {
                     demands[id] = demand;
                 }
-            } else if (current_section == "DEPOT_SECTION") {
+            } else if (section == Section::Depot) {
                 int id;
-                data_line_stream >> id;
+                if (!scanner.readInt(id)) throw badData("DEPOT_SECTION");
                 if (id != -1) {
-                    depotId = id;
+                    depotId = id; // With several depots the last one listed wins
                 } else {
-                    current_section = ""; // End of depot section
+                    section = Section::None; // End of depot section
                 }
+            } else if (section == Section::EdgeWeight) {
+                double w;
+                if (!scanner.readDouble(w)) throw badData("EDGE_WEIGHT_SECTION");
+                edgeWeights.push_back(w);
+            } else {
+                scanner.skipLine();
             }
+            continue;
+        }
+
+        std::string_view key = scanner.word();
+        if (key.empty()) {
+            // Stray character at the start of a line (e.g. a lone ':')
+            scanner.skipLine();
+            continue;
+        }
+        scanner.skipColon();
+
+        switch (classify(key)) {
+        case Keyword::Name:
+            name = std::string(scanner.restOfLine());
+            break;
+        case Keyword::Dimension:
+            if (!scanner.readInt(dimension) || dimension < 0) throw badData("DIMENSION");
+            break;
+        case Keyword::Capacity:
+            if (!scanner.readInt(capacity)) throw badData("CAPACITY");
+            break;
+        case Keyword::Vehicles: // Optional tag
+            if (!scanner.readInt(numVehicles)) throw badData("VEHICLES");
+            break;
+        case Keyword::EdgeWeightType:
+            explicitWeights = scanner.word() == "EXPLICIT";
+            break;
+        case Keyword::EdgeWeightFormat: {
+            std::string_view format = scanner.word();
+            if (format == "FULL_MATRIX") weightFormat = WeightFormat::FullMatrix;
+            else if (format == "LOWER_ROW") weightFormat = WeightFormat::LowerRow;
+            else if (format == "LOWER_DIAG_ROW") weightFormat = WeightFormat::LowerDiagRow;
+            else if (format == "UPPER_ROW") weightFormat = WeightFormat::UpperRow;
+            else throw std::runtime_error("Error: unsupported EDGE_WEIGHT_FORMAT " + std::string(format));
+            break;
+        }
+        case Keyword::NodeCoordType: {
+            std::string_view type = scanner.word();
+            if (type == "THREED_COORDS") threeD = true;
+            else if (type != "TWOD_COORDS" && type != "NO_COORDS")
+                throw std::runtime_error("Error: unsupported NODE_COORD_TYPE " + std::string(type));
+            break;
+        }
+        case Keyword::NodeCoordSection:
+            requireDimension("NODE_COORD_SECTION");
+            section = Section::NodeCoord;
+            hasCoords = true;
+            xs.assign(dimension + 1, 0.0); // Nodes are 1-indexed
+            ys.assign(dimension + 1, 0.0);
+            if (threeD) zs.assign(dimension + 1, 0.0);
+            break;
+        case Keyword::DemandSection:
+            requireDimension("DEMAND_SECTION");
+            section = Section::Demand;
+            demands.resize(dimension + 1, 0); // Nodes are 1-indexed
+            break;
+        case Keyword::DepotSection:
+            section = Section::Depot;
+            break;
+        case Keyword::EdgeWeightSection:
+            requireDimension("EDGE_WEIGHT_SECTION");
+            section = Section::EdgeWeight;
+            edgeWeights.reserve(static_cast<std::size_t>(dimension) * dimension);
+            break;
+        case Keyword::Eof:
+            reachedEof = true;
+            break;
+        case Keyword::Unknown:
+            // Other tags (COMMENT, TYPE, ...) and unsupported sections are skipped
+            section = key.size() > 8 && key.substr(key.size() - 8) == "_SECTION" ? Section::Skip : Section::None;
+            scanner.restOfLine();
+            break;
         }
     }
-    file.close();
+
+    if (explicitWeights && weightFormat == WeightFormat::None) {
+        weightFormat = WeightFormat::FullMatrix;
+    }
+    if (!hasCoords) {
+        xs.assign(dimension + 1, 0.0);
+        ys.assign(dimension + 1, 0.0);
+    }
+    if (demands.empty()) {
+        demands.resize(dimension + 1, 0);
+    }
 
     // If numVehicles was not in the file, provide a default upper bound.
     if (numVehicles == 0) {
         numVehicles = dimension > 0 ? dimension - 1 : 0;
     }
-    // Copiar las demandas al vector de nodos
-    for (Node& n : nodes) {
-        if (n.id >= 1 && n.id < demands.size()) {
-            n.demanda = demands[n.id];
-        }
-    }
-
-    // Luego calcular la matriz de distancias
-    computeDistanceMatrix();
+    canComputeOnTheFly = !explicitWeights && zs.empty();
 
-    // After parsing all data, compute the distance matrix.
-    computeDistanceMatrix();
+    // Build the node list (with demands) from the SoA arrays
+    nodes.clear();
+    nodes.reserve(dimension);
+    for (int id = 1; id <= dimension; ++id) {
+        nodes.push_back({id, xs[id], ys[id], demands[id]});
+    }
 }
 
-// Computes the Euclidean distance matrix.
-void VRPLIBReader::computeDistanceMatrix() {
+// Computes the Euclidean distance matrix (or the on-the-fly oracle).
+void VRPLIBReader::computeDistanceMatrix(const ReaderOptions& options) {
     if (nodes.empty()) return;
 
     // Ensure nodes are sorted by ID for consistent matrix access if they weren't in order
@@ -101,17 +400,257 @@ void VRPLIBReader::computeDistanceMatrix() {
     // Note: The above sort is only needed if the file is not guaranteed to list nodes in increasing order of ID.
     // Most VRPLIB instances do, so we'll proceed assuming 1-based indexing corresponds to vector position.
 
-    distanceMatrix.resize(dimension + 1, std::vector<double>(dimension + 1, 0.0));
+    // Assumes node IDs are 1-based and contiguous from 1 to dimension.
+    DistanceBackend backend = resolveBackend(options, dimension, canComputeOnTheFly);
+    if (backend == DistanceBackend::OnTheFly) {
+        distanceMatrix = DistanceMatrix(xs, ys);
+        return;
+    }
+    distanceMatrix = DistanceMatrix(dimension + 1, backend == DistanceBackend::Packed
+                                                       ? DistanceMatrix::Storage::PackedSymmetric
+                                                       : DistanceMatrix::Storage::Full);
+    if (explicitWeights) {
+        fillExplicitWeights();
+    } else if (!zs.empty()) {
+        for (int i = 1; i <= dimension; ++i) {
+            for (int j = 1; j <= i; ++j) {
+                double dx = xs[i] - xs[j];
+                double dy = ys[i] - ys[j];
+                double dz = zs[i] - zs[j];
+                double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+                distanceMatrix.set(i, j, dist);
+                distanceMatrix.set(j, i, dist);
+            }
+        }
+    } else {
+        distanceMatrix.fillEuclidean(xs, ys, 1);
+    }
+}
+
+// Explicit weights and 3D coordinates cannot be computed on the fly.
+DistanceBackend VRPLIBReader::resolveBackend(const ReaderOptions& options, int dim, bool onTheFlyPossible) {
+    DistanceBackend backend = options.backend;
+    if (backend == DistanceBackend::Auto) {
+        std::size_t side = static_cast<std::size_t>(dim) + 1;
+        if (side * side * sizeof(double) <= options.maxDenseBytes) {
+            backend = DistanceBackend::Dense;
+        } else {
+            backend = onTheFlyPossible ? DistanceBackend::OnTheFly : DistanceBackend::Packed;
+        }
+    }
+    if (backend == DistanceBackend::OnTheFly && !onTheFlyPossible) {
+        backend = DistanceBackend::Dense;
+    }
+    return backend;
+}
+
+// Walks the EDGE_WEIGHT_SECTION values in the order given by EDGE_WEIGHT_FORMAT.
+// Matrix row k corresponds to node id k + 1. In Packed storage an asymmetric
+// FULL_MATRIX keeps the lower triangle.
+void VRPLIBReader::fillExplicitWeights() {
+    std::size_t next = 0;
+    auto take = [&]() {
+        if (next >= edgeWeights.size()) {
+            throw std::runtime_error("Error: EDGE_WEIGHT_SECTION has too few values");
+        }
+        return edgeWeights[next++];
+    };
+    auto store = [&](int i, int j, double w) {
+        distanceMatrix.set(i + 1, j + 1, w);
+        distanceMatrix.set(j + 1, i + 1, w);
+    };
+
+    switch (weightFormat) {
+    case WeightFormat::FullMatrix:
+        for (int i = 0; i < dimension; ++i) {
+            for (int j = 0; j < dimension; ++j) {
+                double w = take();
+                if (distanceMatrix.getStorage() == DistanceMatrix::Storage::Full || j <= i) {
+                    distanceMatrix.set(i + 1, j + 1, w);
+                }
+            }
+        }
+        break;
+    case WeightFormat::LowerRow:
+        for (int i = 1; i < dimension; ++i)
+            for (int j = 0; j < i; ++j) store(i, j, take());
+        break;
+    case WeightFormat::LowerDiagRow:
+        for (int i = 0; i < dimension; ++i)
+            for (int j = 0; j <= i; ++j) store(i, j, take());
+        break;
+    case WeightFormat::UpperRow:
+        for (int i = 0; i + 1 < dimension; ++i)
+            for (int j = i + 1; j < dimension; ++j) store(i, j, take());
+        break;
+    case WeightFormat::None:
+        break;
+    }
+
+    edgeWeights.clear();
+    edgeWeights.shrink_to_fit();
+}
+
+// Maps a .vrpbin file and points the matrix and neighbor lists at it.
+bool VRPLIBReader::loadBinary(const std::string& binPath, const SourceStamp* expected, const ReaderOptions& options) {
+    auto mapping = std::make_shared<MappedFile>();
+    try {
+        // The matrix and neighbor lists are read through random lookups
+        *mapping = MappedFile(binPath, MappedFile::Access::Random);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+
+    const char* base = mapping->data();
+    std::uint64_t size = mapping->size();
+    BinaryHeader header;
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0 ||
+        header.version != kBinaryVersion || header.endianTag != kEndianTag ||
+        header.totalBytes != size || header.dimension < 0) {
+        return false;
+    }
+    auto inside = [&](std::uint64_t offset, std::uint64_t bytes) {
+        return offset <= size && bytes <= size - offset;
+    };
+    std::uint64_t side = static_cast<std::uint64_t>(header.dimension) + 1;
+    if (!inside(header.nameOffset, header.nameBytes) ||
+        !inside(header.xsOffset, side * sizeof(double)) ||
+        !inside(header.ysOffset, side * sizeof(double)) ||
+        !inside(header.demandsOffset, side * sizeof(std::int32_t)) ||
+        !inside(header.matrixOffset, header.matrixBytes) ||
+        !inside(header.neighborsOffset, header.neighborsBytes) ||
+        header.neighborsBytes != side * static_cast<std::uint64_t>(header.numNeighbors) * sizeof(std::int32_t)) {
+        return false;
+    }
+
+    if (expected != nullptr) {
+        // A cache entry must come from the same source and match the options
+        if (header.sourceBytes != expected->bytes || header.sourceTime != expected->time) return false;
+        DistanceBackend wanted = resolveBackend(options, header.dimension, header.canComputeOnTheFly != 0);
+        std::int32_t wantedStorage = wanted == DistanceBackend::OnTheFly ? kNoMatrix
+            : static_cast<std::int32_t>(wanted == DistanceBackend::Packed
+                                            ? DistanceMatrix::Storage::PackedSymmetric
+                                            : DistanceMatrix::Storage::Full);
+        if (header.matrixStorage != wantedStorage) return false;
+        // Same clamping as NeighborIndex: at most (customers - 1) neighbors
+        bool hasDepot = header.depotId >= 1 && header.depotId <= header.dimension;
+        int maxNeighbors = std::max(0, header.dimension - (hasDepot ? 1 : 0) - 1);
+        if (header.numNeighbors != std::min(std::max(options.numNeighbors, 0), maxNeighbors)) return false;
+    }
 
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        for (size_t j = i; j < nodes.size(); ++j) {
-            double dist = std::sqrt(std::pow(nodes[i].x - nodes[j].x, 2) +
-                                    std::pow(nodes[i].y - nodes[j].y, 2));
-            // Assumes node IDs are 1-based and contiguous from 1 to dimension.
-            distanceMatrix[nodes[i].id][nodes[j].id] = dist;
-            distanceMatrix[nodes[j].id][nodes[i].id] = dist;
+    DistanceMatrix matrixView;
+    if (header.matrixStorage != kNoMatrix) {
+        if (header.matrixStorage != static_cast<std::int32_t>(DistanceMatrix::Storage::Full) &&
+            header.matrixStorage != static_cast<std::int32_t>(DistanceMatrix::Storage::PackedSymmetric)) {
+            return false;
         }
+        auto storage = static_cast<DistanceMatrix::Storage>(header.matrixStorage);
+        if (storage == DistanceMatrix::Storage::Full && header.stride < side) return false;
+        matrixView = DistanceMatrix(reinterpret_cast<const double*>(base + header.matrixOffset),
+                                    header.dimension + 1, storage, header.stride);
+        if (matrixView.bytes() != header.matrixBytes) return false;
+    }
+
+    dimension = header.dimension;
+    name.assign(base + header.nameOffset, header.nameBytes);
+    capacity = header.capacity;
+    numVehicles = header.numVehicles;
+    depotId = header.depotId;
+    canComputeOnTheFly = header.canComputeOnTheFly != 0;
+    fileBytes = header.sourceBytes;
+
+    const double* xsData = reinterpret_cast<const double*>(base + header.xsOffset);
+    const double* ysData = reinterpret_cast<const double*>(base + header.ysOffset);
+    const std::int32_t* demandData = reinterpret_cast<const std::int32_t*>(base + header.demandsOffset);
+    xs.assign(xsData, xsData + side);
+    ys.assign(ysData, ysData + side);
+    demands.assign(demandData, demandData + side);
+
+    nodes.clear();
+    nodes.reserve(dimension);
+    for (int id = 1; id <= dimension; ++id) {
+        nodes.push_back({id, xs[id], ys[id], demands[id]});
+    }
+
+    if (header.matrixStorage == kNoMatrix) {
+        distanceMatrix = DistanceMatrix(xs, ys);
+    } else {
+        distanceMatrix = std::move(matrixView);
     }
+    neighborIndex = NeighborIndex(reinterpret_cast<const int*>(base + header.neighborsOffset),
+                                  dimension + 1, header.numNeighbors);
+
+    binaryMapping = std::move(mapping);
+    fromBinary = true;
+    return true;
+}
+
+void VRPLIBReader::writeBinary(const std::string& binPath) const {
+    writeBinary(binPath, SourceStamp{fileBytes, 0});
+}
+
+// Writes the binary format through a temporary file and a rename, so concurrent
+// runs never map a half-written cache. Failures are silent: the cache is optional.
+void VRPLIBReader::writeBinary(const std::string& binPath, const SourceStamp& stamp) const {
+    std::uint64_t side = static_cast<std::uint64_t>(dimension) + 1;
+    bool hasMatrix = distanceMatrix.getStorage() != DistanceMatrix::Storage::OnTheFly;
+
+    BinaryHeader header {};
+    std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.version = kBinaryVersion;
+    header.endianTag = kEndianTag;
+    header.sourceBytes = stamp.bytes;
+    header.sourceTime = stamp.time;
+    header.dimension = dimension;
+    header.capacity = capacity;
+    header.numVehicles = numVehicles;
+    header.depotId = depotId;
+    header.numNeighbors = neighborIndex.getK();
+    header.matrixStorage = hasMatrix ? static_cast<std::int32_t>(distanceMatrix.getStorage()) : kNoMatrix;
+    header.canComputeOnTheFly = canComputeOnTheFly ? 1 : 0;
+    header.stride = distanceMatrix.getStride();
+
+    header.nameOffset = sizeof(header);
+    header.nameBytes = name.size();
+    header.xsOffset = alignOffset(header.nameOffset + header.nameBytes);
+    header.ysOffset = alignOffset(header.xsOffset + side * sizeof(double));
+    header.demandsOffset = alignOffset(header.ysOffset + side * sizeof(double));
+    header.matrixOffset = alignOffset(header.demandsOffset + side * sizeof(std::int32_t));
+    header.matrixBytes = hasMatrix ? distanceMatrix.bytes() : 0;
+    header.neighborsOffset = alignOffset(header.matrixOffset + header.matrixBytes);
+    header.neighborsBytes = side * static_cast<std::uint64_t>(header.numNeighbors) * sizeof(std::int32_t);
+    header.totalBytes = header.neighborsOffset + header.neighborsBytes;
+
+    std::string tmpPath = binPath + temporarySuffix();
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        auto writeAt = [&](std::uint64_t offset, const void* bytes, std::uint64_t count) {
+            static const char zeros[DistanceMatrix::kAlignment] = {};
+            std::uint64_t pos = static_cast<std::uint64_t>(out.tellp());
+            if (pos < offset) out.write(zeros, static_cast<std::streamsize>(offset - pos));
+            if (count > 0) out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+        };
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.nameOffset, name.data(), header.nameBytes);
+        writeAt(header.xsOffset, xs.data(), side * sizeof(double));
+        writeAt(header.ysOffset, ys.data(), side * sizeof(double));
+        writeAt(header.demandsOffset, demands.data(), side * sizeof(std::int32_t));
+        writeAt(header.matrixOffset, distanceMatrix.buffer(), header.matrixBytes);
+        writeAt(header.neighborsOffset, neighborIndex.buffer(), header.neighborsBytes);
+        if (!out) {
+            out.close();
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, binPath, ec);
+    if (ec) std::filesystem::remove(tmpPath, ec);
 }
 
 // --- Getter Implementations ---
@@ -123,4 +662,28 @@ int VRPLIBReader::getNumVehicles() const { return numVehicles; }
 const std::vector<Node>& VRPLIBReader::getNodes() const { return nodes; }
 const std::vector<int>& VRPLIBReader::getDemands() const { return demands; }
 int VRPLIBReader::getDepotId() const { return depotId; }
-const std::vector<std::vector<double>>& VRPLIBReader::getDistanceMatrix() const { return distanceMatrix; }
\ No newline at end of file
+const DistanceMatrix& VRPLIBReader::getDistanceMatrix() const { return distanceMatrix; }
+const std::vector<double>& VRPLIBReader::getXs() const { return xs; }
+const std::vector<double>& VRPLIBReader::getYs() const { return ys; }
+std::size_t VRPLIBReader::getFileBytes() const { return fileBytes; }
+const NeighborIndex& VRPLIBReader::getNeighbors() const { return neighborIndex; }
+bool VRPLIBReader::isFromBinary() const { return fromBinary; }
+
+bool VRPLIBReader::isPlanarEuclidean() const { return canComputeOnTheFly; }
+
+std::vector<std::string> listInstanceFiles(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    if (!fs::is_directory(path)) {
+        files.push_back(path);
+        return files;
+    }
+    for (const auto& entry : fs::directory_iterator(path)) {
+        std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".dat" || extension == ".DAT" || extension == ".vrp")) {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
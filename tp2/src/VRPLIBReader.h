@@ -1,8 +1,32 @@
 #ifndef VRPLIB_READER_H
 #define VRPLIB_READER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
+#include "DistanceMatrix.h"
+#include "NeighborIndex.h"
+
+class MappedFile;
+
+// How the distances between nodes are stored.
+// Auto uses a dense Full matrix unless it would exceed maxDenseBytes, in which
+// case it falls back to computing distances on the fly from the coordinates
+// (or to a Packed matrix when the instance gives explicit edge weights).
+enum class DistanceBackend { Auto, Dense, Packed, OnTheFly };
+
+// Options that control how an instance is loaded
+struct ReaderOptions {
+    DistanceBackend backend = DistanceBackend::Auto;
+    std::size_t maxDenseBytes = std::size_t(512) << 20; // 512 MiB
+    // Length of the nearest-neighbor list kept for every node (0 disables it)
+    int numNeighbors = 10;
+    // Load the instance from "<file>.vrpbin" when it is up to date; otherwise
+    // parse the text file and (re)write the cache next to it
+    bool useBinaryCache = false;
+};
 
 // A structure to represent a node (customer or depot)
 struct Node {
@@ -14,8 +38,12 @@ struct Node {
 
 class VRPLIBReader {
 public:
-    // Constructor that takes the path to the VRPLIB file
-    explicit VRPLIBReader(const std::string& filePath);
+    // Constructor that takes the path to the VRPLIB file. A path ending in
+    // ".vrpbin" is loaded directly as a binary instance.
+    explicit VRPLIBReader(const std::string& filePath, const ReaderOptions& options = ReaderOptions());
+
+    // Writes the instance in the binary .vrpbin format (see VRPLIBReader.cpp)
+    void writeBinary(const std::string& binPath) const;
 
     // --- Getter methods to access the parsed data ---
 
@@ -26,7 +54,19 @@ public:
     const std::vector<Node>& getNodes() const;
     const std::vector<int>& getDemands() const;
     int getDepotId() const;
-    const std::vector<std::vector<double>>& getDistanceMatrix() const;
+    const DistanceMatrix& getDistanceMatrix() const;
+    // Node coordinates as SoA arrays indexed by node id (entry 0 unused)
+    const std::vector<double>& getXs() const;
+    const std::vector<double>& getYs() const;
+    // Size in bytes of the instance file that was parsed
+    std::size_t getFileBytes() const;
+    // Nearest customers of every node, closest first
+    const NeighborIndex& getNeighbors() const;
+    // True if the instance came from a .vrpbin file instead of the text parser
+    bool isFromBinary() const;
+    // True if distances are the plane Euclidean distances between the
+    // coordinates (no explicit edge weights, no 3D coordinates)
+    bool isPlanarEuclidean() const;
 
 private:
     // --- Member variables to store instance data ---
@@ -38,15 +78,52 @@ private:
     int depotId {0};
     std::vector<Node> nodes;
     std::vector<int> demands;
-    std::vector<std::vector<double>> distanceMatrix;
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<double> zs; // Only for NODE_COORD_TYPE : THREED_COORDS
+    DistanceMatrix distanceMatrix;
+    NeighborIndex neighborIndex;
+    std::size_t fileBytes {0};
+    bool fromBinary {false};
+    // False for explicit edge weights and 3D coordinates
+    bool canComputeOnTheFly {true};
+
+    // Mapping of a loaded .vrpbin file; the matrix and neighbor lists are views
+    // into it, so it lives as long as the reader (and its copies)
+    std::shared_ptr<const MappedFile> binaryMapping;
+
+    // EDGE_WEIGHT_SECTION values, kept until the matrix is built
+    enum class WeightFormat { None, FullMatrix, LowerRow, LowerDiagRow, UpperRow };
+    WeightFormat weightFormat {WeightFormat::None};
+    bool explicitWeights {false};
+    std::vector<double> edgeWeights;
 
     // --- Private helper methods for parsing and computation ---
 
     // Main parsing method, called by the constructor
     void parse(const std::string& filePath);
 
-    // Computes the Euclidean distance matrix after parsing node coordinates
-    void computeDistanceMatrix();
+    // Builds the distance backend after parsing
+    void computeDistanceMatrix(const ReaderOptions& options);
+
+    // Backend that computeDistanceMatrix builds for these options and dimension
+    static DistanceBackend resolveBackend(const ReaderOptions& options, int dim, bool onTheFlyPossible);
+
+    // Loads a .vrpbin file. When `expected` is given (cache lookup) the file must
+    // match the source stamp and the options, otherwise it is a miss (false).
+    struct SourceStamp {
+        std::uint64_t bytes {0};
+        std::int64_t time {0};
+    };
+    bool loadBinary(const std::string& binPath, const SourceStamp* expected, const ReaderOptions& options);
+    void writeBinary(const std::string& binPath, const SourceStamp& stamp) const;
+
+    // Fills a Full or Packed matrix from the EDGE_WEIGHT_SECTION values
+    void fillExplicitWeights();
 };
 
+// Instance files to run on: `path` itself if it is a file, otherwise the
+// .dat / .DAT / .vrp files directly inside the directory, sorted by path
+std::vector<std::string> listInstanceFiles(const std::string& path);
+
 #endif // VRPLIB_READER_H
\ No newline at end of file
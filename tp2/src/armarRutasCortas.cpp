@@ -3,47 +3,63 @@
 #include <limits>    // Para usar std::numeric_limits<double>::max() si reemplazas 1e9 
 #include <vector>
 #include "CVRP_Solution.h"
-#include "armarrutascortas.h" 
+#include "armarRutasCortas.h"
 #include "VRPLIBReader.h"
+#include "SpatialGrid.h"
 using namespace std;
 
 
-vector<vector<int>> armarRutasCortas(const vector<Cliente>& clientes,int capacidad,const vector<vector<double>>& distancias) {
-    int n = clientes.size();
+vector<vector<int>> armarRutasCortas(const InstanceView& instancia) {
+    const DistanceMatrix& distancias = instancia.getDistanceMatrix();
+    const vector<int>& ids = instancia.getIds();
+    const vector<int>& demandas = instancia.getDemands();
+    int capacidad = instancia.getCapacity();
+    int n = instancia.size();
     vector<bool> visitado(n, false);
     visitado[0] = true;
 
+    // En instancias planas, el más cercano que entra sale de la grilla
+    bool usarGrilla = instancia.isPlanarEuclidean();
+    SpatialGrid grilla;
+    if (usarGrilla) grilla = SpatialGrid(instancia);
+
     vector<vector<int>> rutas;
 
     while (true) {
         int carga = 0;
         int actual = 0;
         vector<int> ruta;
-        ruta.push_back(clientes[0].id);
+        ruta.push_back(ids[0]);
 
         while (true) {
             int mejor = -1;
-            double distMin = numeric_limits<double>::max();
-
-            for (int i = 1; i < n; i++) {
-                if (!visitado[i] && clientes[i].demanda + carga <= capacidad) {
-                    double d = distancias[clientes[actual].id][clientes[i].id];
-                    if (d < distMin) {
-                        distMin = d;
-                        mejor = i;
+            if (usarGrilla) {
+                mejor = grilla.nearest(actual, capacidad - carga);
+            } else {
+                double distMin = numeric_limits<double>::max();
+                const double* fila = distancias.row(ids[actual]);
+
+                for (int i = 1; i < n; i++) {
+                    if (!visitado[i] && demandas[i] + carga <= capacidad) {
+                        double d = fila[ids[i]];
+                        if (d < distMin) {
+                            distMin = d;
+                            mejor = i;
+                        }
                     }
                 }
             }
 
             if (mejor == -1) break;
 
-            ruta.push_back(clientes[mejor].id);
-            carga += clientes[mejor].demanda;
+            ruta.push_back(ids[mejor]);
+            carga += demandas[mejor];
             visitado[mejor] = true;
+            if (usarGrilla) grilla.remove(mejor);
             actual = mejor;
         }
 
-        ruta.push_back(clientes[0].id);
+        ruta.push_back(ids[0]);
         rutas.push_back(ruta);
 
         bool todosVisitados = true;
@@ -59,6 +75,10 @@ vector<vector<int>> armarRutasCortas(const vector<Cliente>& clientes,int capacid
     return rutas;
 }
 
+vector<vector<int>> armarRutasCortas(const vector<Cliente>& clientes,int capacidad,const DistanceMatrix& distancias) {
+    return armarRutasCortas(InstanceView(clientes, capacidad, &distancias));
+}
+
 /*
 -----------------------------------------------------------
 Complejidad del algoritmo armarRutasCortas
@@ -76,45 +96,25 @@ Sea n la cantidad total de nodos (incluido el depósito).
 Por lo tanto, la complejidad temporal total en el peor caso es:
 
     O(n) rutas × O(n) iteraciones por ruta × O(n) comparaciones = O(n³)
-*/
-
-Solution solveGreedy(const VRPLIBReader& instance){
-    
-    vector<Node> nodos = instance.getNodes();
-    vector<int> demandas = instance.getDemands();
-    vector<Cliente> clientes;
-
-    for (const auto& nodo : nodos) {
-        Cliente c;
-        c.id = nodo.id;
-        c.x = nodo.x;
-        c.y = nodo.y;
-        c.demanda = demandas[nodo.id];
-        clientes.push_back(c);
-    }
 
+(En realidad hay un paso por cliente, así que el recorrido lineal da O(n²).)
 
-    const auto& distancias = instance.getDistanceMatrix();
-    int capacidad = instance.getCapacity();
-    vector<vector<int>> rutas = armarRutasCortas(clientes, capacidad, distancias);
+Con la grilla (SpatialGrid, solo en instancias planas), cada búsqueda mira las
+celdas cercanas que todavía tienen algún cliente que entre: con clientes
+repartidos en el plano es O(1) celdas por paso, y borrar un cliente es O(1)
+(más recalcular la demanda mínima de su celda). Al cerrar cada ruta la
+búsqueda no encuentra nada y puede recorrer toda la grilla, O(n). En total,
+típicamente O(n + rutas × n), frente a O(n²) del recorrido lineal.
+*/
 
+Solution solveGreedy(const VRPLIBReader& instance){
+    InstanceView instancia(instance);
+    vector<vector<int>> rutas = armarRutasCortas(instancia);
 
     Solution sol;
     for (const auto& ruta : rutas) {
-    int suma_demanda = 0;
-    for (int i = 1; i < ruta.size() - 1; ++i) { // excluye el depósito al inicio y fin
-        int cliente_id = ruta[i];
-        suma_demanda += clientes[cliente_id].demanda;
+        sol.agregarRuta(ruta, instancia.getDistanceMatrix(), instancia.routeLoad(ruta));
     }
-    sol.agregarRuta(ruta, distancias, suma_demanda);
-}
-
 
     return sol;
 }
-
-
-
-
-
-
@@ -4,13 +4,18 @@
 #include <vector>
 #include "VRPLIBReader.h"
 #include "CVRP_Solution.h"
+#include "InstanceView.h"
 
 
+// Vecino más cercano: cada ruta sale del depósito y agrega el cliente más
+// cercano que entra en el vehículo hasta que no entra ninguno
+std::vector<std::vector<int>> armarRutasCortas(const InstanceView& instancia);
 
+// Igual, sobre una lista de clientes con el depósito en la posición 0
 std::vector<std::vector<int>> armarRutasCortas(
     const std::vector<Cliente>& clientes,
     int capacidad,
-    const std::vector<std::vector<double>>& distancias
+    const DistanceMatrix& distancias
 );
 
 
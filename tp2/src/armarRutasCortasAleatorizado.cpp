@@ -1,62 +1,154 @@
 #include "armarRutasCortasAleatorizado.h"
+#include "Trace.h"
 #include <limits>
 #include <random>
 #include <algorithm>
 
-std::vector<std::vector<int>> armarRutasCortasAleatorizado(
-    const std::vector<Cliente>& clientes,
-    int capacidad,
-    const std::vector<std::vector<double>>& distancias,
-    int rcl_size) {
-
-    int n = clientes.size();
-    std::vector<bool> visitado(n, false);
-    visitado[0] = true;
-    std::vector<std::vector<int>> rutas;
+ConstructorRCL ConstructorRCL::porCardinalidad(int tamanio) {
+    return ConstructorRCL(std::max(1, tamanio), -1.0);
+}
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
+ConstructorRCL ConstructorRCL::porValor(double alfa) {
+    return ConstructorRCL(1, std::min(1.0, std::max(0.0, alfa)));
+}
 
-    while (true) {
-        int carga = 0;
-        int actual = 0;
-        std::vector<int> ruta;
-        ruta.push_back(clientes[0].id);
+int ConstructorRCL::elegir(int actual, const double* fila, const std::vector<int>& ids,
+                           const std::vector<int>& demandas, int n, int espacio, std::mt19937& gen) {
+    if (alfa < 0.0 && usarGrilla) {
+        // La grilla ya devuelve los `tamanio` más cercanos, ordenados
+        grilla.nearest(actual, espacio, tamanio, mejores);
+        if (mejores.empty()) return -1;
+        std::uniform_int_distribution<> distrib(0, static_cast<int>(mejores.size()) - 1);
+        return mejores[distrib(gen)].second;
+    }
 
-        while (true) {
-            std::vector<std::pair<int, double>> candidatos;
-            for (int i = 1; i < n; ++i) {
-                if (!visitado[i] && clientes[i].demanda + carga <= capacidad) {
-                    double d = distancias[clientes[actual].id][clientes[i].id];
-                    candidatos.emplace_back(i, d);
-                }
+    if (alfa < 0.0) {
+        // Heap de máximos con los `tamanio` más cercanos vistos hasta ahora;
+        // a igual distancia, el de índice menor
+        mejores.clear();
+        for (int i = 1; i < n; ++i) {
+            if (visitado[i] || demandas[i] > espacio) continue;
+            std::pair<double, int> c(fila[ids[i]], i);
+            if (static_cast<int>(mejores.size()) < tamanio) {
+                mejores.push_back(c);
+                std::push_heap(mejores.begin(), mejores.end());
+            } else if (c < mejores.front()) {
+                std::pop_heap(mejores.begin(), mejores.end());
+                mejores.back() = c;
+                std::push_heap(mejores.begin(), mejores.end());
             }
+        }
+        if (mejores.empty()) return -1;
+
+        std::sort_heap(mejores.begin(), mejores.end());
+        std::uniform_int_distribution<> distrib(0, static_cast<int>(mejores.size()) - 1);
+        return mejores[distrib(gen)].second;
+    }
 
-            if (candidatos.empty()) break;
+    candidatos.clear();
+    double dmin = std::numeric_limits<double>::infinity();
+    double dmax = -dmin;
+    for (int i = 1; i < n; ++i) {
+        if (visitado[i] || demandas[i] > espacio) continue;
+        double d = fila[ids[i]];
+        candidatos.emplace_back(d, i);
+        dmin = std::min(dmin, d);
+        dmax = std::max(dmax, d);
+    }
+    if (candidatos.empty()) return -1;
 
-            std::sort(candidatos.begin(), candidatos.end(),
-                      [](const auto& a, const auto& b) { return a.second < b.second; });
+    // Los que pasan el umbral se compactan al principio del buffer
+    double umbral = dmin + alfa * (dmax - dmin);
+    size_t enRCL = 0;
+    for (const auto& c : candidatos) {
+        if (c.first <= umbral) candidatos[enRCL++] = c;
+    }
+    std::uniform_int_distribution<size_t> distrib(0, enRCL - 1);
+    return candidatos[distrib(gen)].second;
+}
 
-            int limite = std::min(rcl_size, static_cast<int>(candidatos.size()));
-            std::uniform_int_distribution<> distrib(0, limite - 1);
-            int elegido = candidatos[distrib(gen)].first;
+std::vector<std::vector<int>> ConstructorRCL::construir(const InstanceView& instancia, std::mt19937& gen) {
+    TRACE_SCOPE("armarRutasCortasAleatorizado");
+    const DistanceMatrix& distancias = instancia.getDistanceMatrix();
+    const std::vector<int>& ids = instancia.getIds();
+    const std::vector<int>& demandas = instancia.getDemands();
+    int capacidad = instancia.getCapacity();
+    int n = instancia.size();
+
+    // assign no libera memoria: desde la segunda construcción no se reserva nada
+    visitado.assign(n, 0);
+    visitado[0] = 1;
+    // La grilla se arma una vez por instancia y después solo se repone. La
+    // dirección sola no alcanza: otra instancia puede ocupar la misma.
+    usarGrilla = alfa < 0.0 && instancia.isPlanarEuclidean();
+    if (usarGrilla) {
+        if (indexada != &instancia || uidIndexada != instancia.getUid()) {
+            grilla = SpatialGrid(instancia);
+            indexada = &instancia;
+            uidIndexada = instancia.getUid();
+        } else {
+            grilla.reset();
+        }
+    }
+    mejores.reserve(tamanio);
+    candidatos.reserve(n);
+    int pendientes = n - 1;
+    std::vector<std::vector<int>> rutas;
 
-            ruta.push_back(clientes[elegido].id);
-            carga += clientes[elegido].demanda;
-            visitado[elegido] = true;
+    while (pendientes > 0) {
+        int carga = 0;
+        int actual = 0;
+        std::vector<int> ruta;
+        ruta.push_back(ids[0]);
+
+        while (true) {
+            // La fila solo hace falta en el recorrido lineal: con la grilla,
+            // una matriz OnTheFly la calcularía entera en cada paso
+            const double* fila = usarGrilla ? nullptr : distancias.row(ids[actual]);
+            int elegido = elegir(actual, fila, ids, demandas, n, capacidad - carga, gen);
+            if (elegido < 0) break;
+
+            ruta.push_back(ids[elegido]);
+            carga += demandas[elegido];
+            visitado[elegido] = 1;
+            if (usarGrilla) grilla.remove(elegido);
+            --pendientes;
             actual = elegido;
         }
 
-        ruta.push_back(clientes[0].id);
+        ruta.push_back(ids[0]);
         rutas.push_back(ruta);
 
-        if (std::all_of(visitado.begin() + 1, visitado.end(), [](bool v) { return v; }))
-            break;
+        // Un cliente con demanda mayor a la capacidad no entra en ninguna ruta
+        if (ruta.size() == 2) break;
     }
 
     return rutas;
 }
 
+std::vector<std::vector<int>> armarRutasCortasAleatorizado(
+    const InstanceView& instancia,
+    int rcl_size,
+    std::mt19937& gen) {
+    return ConstructorRCL::porCardinalidad(rcl_size).construir(instancia, gen);
+}
+
+std::vector<std::vector<int>> armarRutasCortasAleatorizado(
+    const InstanceView& instancia,
+    int rcl_size) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    return armarRutasCortasAleatorizado(instancia, rcl_size, gen);
+}
+
+std::vector<std::vector<int>> armarRutasCortasAleatorizado(
+    const std::vector<Cliente>& clientes,
+    int capacidad,
+    const DistanceMatrix& distancias,
+    int rcl_size) {
+    return armarRutasCortasAleatorizado(InstanceView(clientes, capacidad, &distancias), rcl_size);
+}
+
 /*
 -----------------------------------------------------------
 Complejidad del algoritmo armarRutasCortasAleatorizado
@@ -71,16 +163,29 @@ Análisis:
 - El algoritmo recorre los clientes hasta que todos fueron visitados.
 - En cada iteración externa (por cada ruta generada), se construye una ruta válida:
     - Se evalúan hasta O(n) clientes no visitados.
-    - Se calcula la distancia y se arma un vector de candidatos: O(n)
-    - Luego se ordena ese vector (para tomar los mejores): O(n log n)
-    - Se elige un candidato aleatoriamente dentro del top `rcl_size`: O(1)
-
-En el peor caso, hay hasta O(n) rutas (una por cliente), por lo que:
-
-    → Costo total = O(n) rutas × O(n log n) cada una = **O(n² log n)**
-
-Este algoritmo es más eficiente que la versión determinista (greedy pura, O(n³)), 
-ya que evita la comparación exhaustiva y privilegia un subconjunto de buenas opciones.
+    - RCL por cardinalidad: la grilla (SpatialGrid) recorre solo las celdas
+      cercanas con algún cliente que entre y guarda los `rcl_size` mejores en
+      un heap acotado. Con clientes repartidos en el plano son O(rcl_size)
+      celdas por paso, salvo al cerrar la ruta (nadie entra), que puede
+      recorrer toda la grilla. Sin coordenadas euclídeas se recorren todos los
+      candidatos: O(n log rcl_size).
+    - RCL por valor: una pasada para dmin/dmax y otra para filtrar por el
+      umbral: O(n).
+    - Se elige un candidato aleatoriamente dentro de la RCL: O(1)
+
+Hay un paso por cliente agregado, así que:
+
+    → Peor caso = O(n) pasos × O(n log rcl_size) cada uno = **O(n² log rcl_size)**
+    → Con la grilla, típicamente O(n log rcl_size + rutas × n)
+
+Los buffers (visitados, heap, candidatos) viven en el ConstructorRCL: no se
+reserva memoria por paso, y reusando el constructor tampoco por construcción
+(salvo las rutas que se devuelven).
+
+Frente a la versión determinista (armarRutasCortas) el costo es del mismo orden:
+aquella busca solo el más cercano, O(n²) con el recorrido lineal y típicamente
+O(n + rutas × n) con la grilla; acá cada paso guarda rcl_size candidatos en vez
+de uno, lo que agrega el factor log rcl_size y la elección al azar.
 
 -----------------------------------------------------------
 */
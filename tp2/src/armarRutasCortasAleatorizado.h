@@ -2,13 +2,64 @@
 #define ARMAR_RUTAS_CORTAS_ALEATORIZADO_H
 
 #include "Cliente.h"
+#include <cstdint>
+#include <random>
+#include <utility>
 #include <vector>
+#include "DistanceMatrix.h"
+#include "InstanceView.h"
+#include "SpatialGrid.h"
 
-// Similar a armarRutasCortas, pero con aleatoriedad controlada por RCL
+// Constructor greedy aleatorizado: como armarRutasCortas, pero en cada paso
+// elige al azar dentro de una lista restringida de candidatos (RCL).
+// Los buffers se reservan en la primera construcción y se reutilizan en las
+// siguientes, así que conviene un constructor por hilo que dure todo GRASP.
+class ConstructorRCL {
+public:
+    // RCL por cardinalidad: los `tamanio` clientes factibles más cercanos
+    static ConstructorRCL porCardinalidad(int tamanio);
+    // RCL por valor: los factibles con d <= dmin + α·(dmax − dmin), α en [0, 1]
+    static ConstructorRCL porValor(double alfa);
+
+    std::vector<std::vector<int>> construir(const InstanceView& instancia, std::mt19937& gen);
+
+private:
+    ConstructorRCL(int tamanio, double alfa) : tamanio(tamanio), alfa(alfa) {}
+
+    // Índice (denso) del cliente elegido desde `actual`, o -1 si ninguno entra.
+    // `fila` son las distancias desde `actual`; con la grilla no se usa (nullptr).
+    int elegir(int actual, const double* fila, const std::vector<int>& ids,
+               const std::vector<int>& demandas, int n, int espacio, std::mt19937& gen);
+
+    int tamanio;
+    double alfa;                                     // < 0: RCL por cardinalidad
+    std::vector<char> visitado;
+    std::vector<std::pair<double, int>> mejores;     // heap de a lo sumo `tamanio`
+    std::vector<std::pair<double, int>> candidatos;  // factibles del paso (RCL por valor)
+    // Clientes sin rutear, para la RCL por cardinalidad en instancias planas
+    SpatialGrid grilla;
+    const InstanceView* indexada {nullptr};    // instancia de la grilla (dirección y uid)
+    std::uint64_t uidIndexada {0};
+    bool usarGrilla {false};
+};
+
+// Similar a armarRutasCortas, pero con aleatoriedad controlada por RCL.
+// Usa el generador dado, así una misma semilla da las mismas rutas.
+std::vector<std::vector<int>> armarRutasCortasAleatorizado(
+    const InstanceView& instancia,
+    int rcl_size,
+    std::mt19937& gen);
+
+// Igual, con un generador sembrado desde std::random_device
+std::vector<std::vector<int>> armarRutasCortasAleatorizado(
+    const InstanceView& instancia,
+    int rcl_size);
+
+// Igual, sobre una lista de clientes con el depósito en la posición 0
 std::vector<std::vector<int>> armarRutasCortasAleatorizado(
     const std::vector<Cliente>& clientes,
     int capacidad,
-    const std::vector<std::vector<double>>& distancias,
+    const DistanceMatrix& distancias,
     int rcl_size);
 
 #endif
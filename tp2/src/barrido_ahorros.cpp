@@ -0,0 +1,106 @@
+#include "barrido_ahorros.h"
+#include "busqueda_local.h"
+#include "InstanceView.h"
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+std::vector<ParametrosAhorro> grillaAhorros() {
+    std::vector<ParametrosAhorro> grilla;
+    for (double lambda : {0.6, 0.8, 1.0, 1.2, 1.4}) {
+        for (double mu : {0.0, 0.5, 1.0}) {
+            for (double nu : {0.0, 0.5}) {
+                grilla.push_back({lambda, mu, nu});
+            }
+        }
+    }
+    return grilla;
+}
+
+Solution barridoAhorros(const VRPLIBReader& reader, const ConfigBarrido& config,
+                        VND* vnd, ParametrosAhorro* mejores) {
+    const std::vector<ParametrosAhorro> grilla = config.grilla.empty() ? grillaAhorros() : config.grilla;
+    int combinaciones = static_cast<int>(grilla.size());
+
+    // Lo que no depende de los parámetros se calcula una vez para todos
+    InstanceView instancia(reader);
+    TerminosAhorro terminos(instancia);
+    const auto& distancias = reader.getDistanceMatrix();
+    ContextoBusqueda ctx{distancias, reader.getDemands(), reader.getCapacity(), &reader.getNeighbors()};
+    VND vnd_estandar = VND::estandar();
+    if (vnd == nullptr) vnd = &vnd_estandar;
+
+    int hilos = config.hilos > 0 ? config.hilos : static_cast<int>(std::thread::hardware_concurrency());
+    hilos = std::max(1, std::min(hilos, combinaciones));
+
+    // Igual que en grasp(): lectura atómica del mejor costo y lock solo al mejorar
+    std::atomic<double> mejorCosto{std::numeric_limits<double>::infinity()};
+    std::mutex mutexMejor;
+    std::vector<std::vector<int>> mejoresRutas;
+    std::vector<int> mejoresCargas;
+    int mejorIndice = -1;
+
+    std::atomic<int> siguiente{0};
+    std::vector<VND> vnds(hilos, *vnd);
+    for (VND& v : vnds) v.reiniciarEstadisticas();
+
+    auto trabajador = [&](int h) {
+        for (int k = siguiente.fetch_add(1); k < combinaciones; k = siguiente.fetch_add(1)) {
+            EstadoRutas estado(clarkewright(terminos, grilla[k]), ctx);
+            double costo = vnds[h].ejecutar(estado, ctx);
+
+            if (costo > mejorCosto.load(std::memory_order_relaxed)) continue;
+            std::unique_lock<std::mutex> lock(mutexMejor, std::defer_lock);
+            {
+                TRACE_SCOPE("esperaLock");
+                lock.lock();
+            }
+            TRACE_SCOPE("publicarIncumbente");
+            double actual = mejorCosto.load(std::memory_order_relaxed);
+            if (costo < actual || (costo == actual && k < mejorIndice)) {
+                mejorCosto.store(costo, std::memory_order_relaxed);
+                mejorIndice = k;
+                mejoresRutas = std::move(estado.rutas);
+                mejoresCargas = std::move(estado.carga);
+            }
+        }
+    };
+
+    if (hilos == 1) {
+        trabajador(0);
+    } else {
+        std::vector<std::thread> pool;
+        for (int h = 0; h < hilos; ++h) pool.emplace_back(trabajador, h);
+        for (auto& t : pool) t.join();
+    }
+
+    for (const VND& v : vnds) vnd->sumarEstadisticas(v);
+    if (mejores != nullptr && mejorIndice >= 0) *mejores = grilla[mejorIndice];
+
+    Solution mejorSol;
+    mejorSol.reservar(instancia.size() + static_cast<int>(mejoresRutas.size()), static_cast<int>(mejoresRutas.size()));
+    for (size_t r = 0; r < mejoresRutas.size(); ++r) {
+        mejorSol.agregarRuta(mejoresRutas[r], distancias, mejoresCargas[r]);
+    }
+    return mejorSol;
+}
+
+/*
+-----------------------------------------------------------
+Complejidad del barrido de ahorros
+-----------------------------------------------------------
+
+Sea P la cantidad de combinaciones (λ, μ, ν) de la grilla.
+
+- Términos fijos (distancia al depósito, demanda normalizada): O(n), una vez.
+- Por combinación: Clarke-Wright O(n² log n) + VND.
+
+Total O(P × (n² log n + VND)), con las P corridas repartidas entre hilos:
+tiempo de pared O(P / hilos × (n² log n + VND)). Cada hilo tiene a lo sumo
+un vector de O(n²) ahorros vivo a la vez.
+
+-----------------------------------------------------------
+*/
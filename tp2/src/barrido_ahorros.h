@@ -0,0 +1,28 @@
+#ifndef BARRIDO_AHORROS_H
+#define BARRIDO_AHORROS_H
+
+#include "VRPLIBReader.h"
+#include "CVRP_Solution.h"
+#include "clarkewright.h"
+#include "vnd.h"
+#include <vector>
+
+struct ConfigBarrido {
+    // Combinaciones (λ, μ, ν) a probar; vacía = grillaAhorros()
+    std::vector<ParametrosAhorro> grilla;
+    int hilos = 0;               // 0 = todos los núcleos
+};
+
+// Grilla por defecto: λ ∈ {0.6, 0.8, 1.0, 1.2, 1.4}, μ ∈ {0, 0.5, 1},
+// ν ∈ {0, 0.5} (30 combinaciones, incluye el Clarke-Wright clásico)
+std::vector<ParametrosAhorro> grillaAhorros();
+
+// Corre Clarke-Wright con cada combinación de la grilla, repartidas entre
+// hilos, mejora cada resultado con una copia del VND (VND::estandar() si es
+// nullptr) y devuelve la mejor solución. Si `mejores` no es nullptr, guarda
+// ahí los parámetros que la generaron. A igual costo gana la combinación que
+// aparece primero en la grilla, así el resultado no depende de los hilos.
+Solution barridoAhorros(const VRPLIBReader& reader, const ConfigBarrido& config,
+                        VND* vnd = nullptr, ParametrosAhorro* mejores = nullptr);
+
+#endif // BARRIDO_AHORROS_H
@@ -0,0 +1,290 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "VRPLIBReader.h"
+#include "InstanceView.h"
+#include "clarkewright.h"
+#include "armarRutasCortas.h"
+#include "busqueda_local.h"
+#include "grasp.h"
+#include "recocido.h"
+#include "vnd.h"
+#include "Trace.h"
+
+using namespace std;
+using namespace std::chrono;
+namespace fs = std::filesystem;
+
+// Corre todos los algoritmos sobre un directorio de instancias, con varias
+// repeticiones y semillas fijas, y compara contra las soluciones de
+// referencia (.HRE). Escribe CSV y JSON para poder diffear entre builds.
+
+struct Medicion {
+    vector<double> tiempos_ms;
+    vector<double> costos;
+    long long mejoras = 0;      // operadores de búsqueda local que mejoraron (en el
+                                // recocido, veces que bajó la mejor solución)
+    long long evaluados = 0;    // movimientos evaluados (solo con kEstadisticas)
+};
+
+struct Fila {
+    string instancia;
+    int clientes;
+    string fase;
+    int repeticiones;
+    double mediana_ms, p95_ms;
+    double costo_mejor, costo_mediana;
+    double referencia;          // NaN si no hay .HRE
+    double gap_mejor, gap_mediana;
+    double mejoras_por_s;
+    double evaluados_por_s;
+};
+
+static string minusculas(string s) {
+    transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return tolower(c); });
+    return s;
+}
+
+// Percentil por rango más cercano
+static double percentil(vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    sort(v.begin(), v.end());
+    size_t k = static_cast<size_t>(max(1.0, ceil(p / 100.0 * v.size())));
+    return v[min(k, v.size()) - 1];
+}
+
+// NAME y COST de cada .HRE; si hay varias soluciones de una instancia, la mejor
+static map<string, double> cargarReferencias(const fs::path& directorio) {
+    map<string, double> referencias;
+    if (!fs::is_directory(directorio)) return referencias;
+    for (const auto& e : fs::directory_iterator(directorio)) {
+        if (minusculas(e.path().extension().string()) != ".hre") continue;
+        ifstream archivo(e.path());
+        string linea, nombre;
+        double costo = numeric_limits<double>::quiet_NaN();
+        while (getline(archivo, linea)) {
+            size_t dos_puntos = linea.find(':');
+            if (dos_puntos == string::npos) continue;
+            string clave, valor;
+            istringstream(linea.substr(0, dos_puntos)) >> clave;
+            istringstream(linea.substr(dos_puntos + 1)) >> valor;
+            if (clave == "NAME") nombre = minusculas(valor);
+            if (clave == "COST") costo = stod(valor);
+        }
+        if (nombre.empty() || costo != costo) continue;
+        auto it = referencias.find(nombre);
+        if (it == referencias.end() || costo < it->second) referencias[nombre] = costo;
+    }
+    return referencias;
+}
+
+// Pico de memoria residente de todo el proceso hasta ahora (no de una fase)
+static long picoMemoriaKB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS uso{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &uso, sizeof uso)) return -1;
+    return static_cast<long>(uso.PeakWorkingSetSize / 1024);
+#else
+    rusage uso{};
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;  // en Linux, KB
+#endif
+}
+
+static string numeroJSON(double x) {
+    if (x != x) return "null";
+    ostringstream s;
+    s << setprecision(10) << x;
+    return s.str();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Uso: " << argv[0] << " <archivo.dat | directorio> [repeticiones] [semilla]"
+             << " [--soluciones dir] [--csv archivo] [--json archivo] [--tiempo ms] [--trace archivo]\n";
+        return 1;
+    }
+
+    fs::path entrada(argv[1]);
+    int repeticiones = 5;
+    uint64_t semilla = 1;
+    fs::path soluciones = (fs::is_directory(entrada) ? entrada : entrada.parent_path()) / "soluciones";
+    string salida_csv = "bench.csv", salida_json = "bench.json";
+    double limite_ms = 0.0;     // > 0: GRASP y recocido por tiempo
+    int posicional = 0;
+    for (int a = 2; a < argc; ++a) {
+        string arg = argv[a];
+        if (arg == "--soluciones" && a + 1 < argc) soluciones = argv[++a];
+        else if (arg == "--csv" && a + 1 < argc) salida_csv = argv[++a];
+        else if (arg == "--json" && a + 1 < argc) salida_json = argv[++a];
+        else if (arg == "--trace" && a + 1 < argc) trace::enable(argv[++a]);
+        else if (arg == "--tiempo" && a + 1 < argc) limite_ms = stod(argv[++a]);
+        else if (posicional++ == 0) repeticiones = max(1, stoi(arg));
+        else semilla = stoull(arg);
+    }
+
+    vector<string> archivos = listInstanceFiles(argv[1]);
+    map<string, double> referencias = cargarReferencias(soluciones);
+
+    vector<Fila> filas;
+    cout << fixed << setprecision(2);
+    for (const string& archivo : archivos) {
+        VRPLIBReader reader(archivo);
+        InstanceView instancia(reader);
+        const DistanceMatrix& distancias = reader.getDistanceMatrix();
+        const NeighborIndex* vecinos = &reader.getNeighbors();
+        ContextoBusqueda ctx{distancias, reader.getDemands(), reader.getCapacity(), vecinos};
+
+        auto ref = referencias.find(minusculas(reader.getName()));
+        double referencia = ref != referencias.end() ? ref->second : numeric_limits<double>::quiet_NaN();
+
+        // Cada fase recibe el número de repetición (para la semilla) y
+        // devuelve sus rutas; las mejoras del VND se suman a la medición
+        vector<pair<string, function<vector<vector<int>>(int, Medicion&)>>> fases = {
+            {"Clarke-Wright", [&](int, Medicion&) { return clarkewright(instancia); }},
+            {"Rutas Cortas", [&](int, Medicion&) { return armarRutasCortas(instancia); }},
+            {"Clarke-Wright + 2-opt", [&](int, Medicion&) {
+                return busquedaLocal2opt(clarkewright(instancia), distancias, vecinos);
+            }},
+            {"Rutas Cortas + Swap", [&](int, Medicion&) {
+                return BusquedaLocalSwap(armarRutasCortas(instancia), distancias, reader.getDemands(),
+                                         reader.getCapacity(), vecinos);
+            }},
+            {"Rutas Cortas + VND", [&](int, Medicion& m) {
+                VND vnd = VND::estandar();
+                EstadoRutas estado(armarRutasCortas(instancia), ctx);
+                vnd.ejecutar(estado, ctx);
+                for (const auto& e : vnd.getEstadisticas()) {
+                    m.mejoras += e.mejoras;
+                    m.evaluados += e.evaluados;
+                }
+                return estado.rutas;
+            }},
+            {"GRASP", [&](int rep, Medicion& m) {
+                ConfigGrasp config;
+                config.semilla = semilla + rep;
+                if (limite_ms > 0.0) {
+                    config.n_iters = 0;
+                    config.limite_ms = limite_ms;
+                }
+                VND vnd = VND::estandar();
+                Solution sol = grasp(reader, config, &vnd);
+                for (const auto& e : vnd.getEstadisticas()) {
+                    m.mejoras += e.mejoras;
+                    m.evaluados += e.evaluados;
+                }
+                return sol.getRutas();
+            }},
+            {"Recocido simulado", [&](int rep, Medicion& m) {
+                ConfigRecocido config;
+                config.semilla = semilla + rep;
+                config.limite_ms = limite_ms;
+                if (limite_ms <= 0.0) config.max_evaluaciones = 2000000;
+                ResultadoRecocido res = recocidoSimulado(reader, config);
+                m.evaluados += res.estadisticas.evaluaciones;
+                m.mejoras += res.estadisticas.mejoras;
+                return res.solucion.getRutas();
+            }},
+        };
+
+        cout << fs::path(archivo).filename().string() << " | n: " << instancia.size() - 1;
+        if (referencia == referencia) cout << " | Referencia: " << referencia;
+        cout << "\n";
+        for (auto& [fase, correr] : fases) {
+            Medicion m;
+            for (int rep = 0; rep < repeticiones; ++rep) {
+                auto t1 = steady_clock::now();
+                vector<vector<int>> rutas = correr(rep, m);
+                auto t2 = steady_clock::now();
+                m.tiempos_ms.push_back(duration<double, milli>(t2 - t1).count());
+                m.costos.push_back(instancia.totalCost(rutas));
+            }
+
+            Fila f;
+            f.instancia = reader.getName();
+            f.clientes = instancia.size() - 1;
+            f.fase = fase;
+            f.repeticiones = repeticiones;
+            f.mediana_ms = percentil(m.tiempos_ms, 50);
+            f.p95_ms = percentil(m.tiempos_ms, 95);
+            f.costo_mejor = *min_element(m.costos.begin(), m.costos.end());
+            f.costo_mediana = percentil(m.costos, 50);
+            f.referencia = referencia;
+            f.gap_mejor = 100.0 * (f.costo_mejor - referencia) / referencia;
+            f.gap_mediana = 100.0 * (f.costo_mediana - referencia) / referencia;
+            double total_s = 0.0;
+            for (double t : m.tiempos_ms) total_s += t / 1000.0;
+            f.mejoras_por_s = total_s > 0 ? m.mejoras / total_s : 0.0;
+            f.evaluados_por_s = total_s > 0 ? m.evaluados / total_s : 0.0;
+            filas.push_back(f);
+
+            cout << "  " << left << setw(24) << fase << right
+                 << " | Mediana: " << setw(9) << f.mediana_ms << " ms"
+                 << " | p95: " << setw(9) << f.p95_ms << " ms"
+                 << " | Costo: " << f.costo_mejor;
+            if (referencia == referencia) cout << " (gap " << f.gap_mejor << "%)";
+            if (m.evaluados > 0) cout << " | Evaluados/s: " << setprecision(0) << f.evaluados_por_s << setprecision(2);
+            if (m.mejoras > 0) cout << " | Mejoras/s: " << f.mejoras_por_s;
+            cout << "\n";
+        }
+    }
+
+    ofstream csv(salida_csv);
+    csv << "instancia,clientes,fase,repeticiones,mediana_ms,p95_ms,costo_mejor,costo_mediana,"
+           "referencia,gap_mejor_pct,gap_mediana_pct,mejoras_por_s,evaluados_por_s\n";
+    csv << setprecision(10);
+    for (const Fila& f : filas) {
+        auto num = [](double x) { return x == x ? numeroJSON(x) : string(); };
+        csv << f.instancia << "," << f.clientes << "," << f.fase << "," << f.repeticiones << ","
+            << num(f.mediana_ms) << "," << num(f.p95_ms) << "," << num(f.costo_mejor) << ","
+            << num(f.costo_mediana) << "," << num(f.referencia) << "," << num(f.gap_mejor) << ","
+            << num(f.gap_mediana) << "," << num(f.mejoras_por_s) << "," << num(f.evaluados_por_s) << "\n";
+    }
+
+    // Una sola vez por corrida: es el pico del proceso entero, no de una fase
+    long pico_memoria_kb = picoMemoriaKB();
+    ofstream json(salida_json);
+    json << "{\n  \"instrumentado\": " << (kEstadisticas ? "true" : "false")
+         << ",\n  \"repeticiones\": " << repeticiones << ",\n  \"semilla\": " << semilla
+         << ",\n  \"limite_grasp_ms\": " << limite_ms
+         << ",\n  \"pico_memoria_proceso_kb\": " << pico_memoria_kb
+         << ",\n  \"resultados\": [\n";
+    for (size_t i = 0; i < filas.size(); ++i) {
+        const Fila& f = filas[i];
+        json << "    {\"instancia\": \"" << f.instancia << "\", \"clientes\": " << f.clientes
+             << ", \"fase\": \"" << f.fase << "\", \"mediana_ms\": " << numeroJSON(f.mediana_ms)
+             << ", \"p95_ms\": " << numeroJSON(f.p95_ms) << ", \"costo_mejor\": " << numeroJSON(f.costo_mejor)
+             << ", \"costo_mediana\": " << numeroJSON(f.costo_mediana)
+             << ", \"referencia\": " << numeroJSON(f.referencia)
+             << ", \"gap_mejor_pct\": " << numeroJSON(f.gap_mejor)
+             << ", \"gap_mediana_pct\": " << numeroJSON(f.gap_mediana)
+             << ", \"mejoras_por_s\": " << numeroJSON(f.mejoras_por_s)
+             << ", \"evaluados_por_s\": " << numeroJSON(f.evaluados_por_s) << "}"
+             << (i + 1 < filas.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+
+    cout << "Pico de memoria del proceso: " << pico_memoria_kb << " KB\n";
+    cout << "Resultados en " << salida_csv << " y " << salida_json << "\n";
+    return 0;
+}
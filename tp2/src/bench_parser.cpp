@@ -0,0 +1,47 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "VRPLIBReader.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Mide el throughput del parser (MB/s) sobre un archivo o un directorio de instancias.
+// Usa el backend OnTheFly y sin listas de vecinos para que el tiempo medido sea
+// el del parseo y no el de la matriz ni el de los k vecinos más cercanos.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Uso: " << argv[0] << " <archivo.dat | directorio> [repeticiones]\n";
+        return 1;
+    }
+
+    vector<string> archivos = listInstanceFiles(argv[1]);
+    int repeticiones = argc >= 3 ? stoi(argv[2]) : 50;
+
+    ReaderOptions opciones;
+    opciones.backend = DistanceBackend::OnTheFly;
+    opciones.numNeighbors = 0;
+
+    size_t bytes = 0;
+    size_t nodos = 0;
+    auto t1 = high_resolution_clock::now();
+    for (int r = 0; r < repeticiones; ++r) {
+        for (const string& archivo : archivos) {
+            VRPLIBReader reader(archivo, opciones);
+            bytes += reader.getFileBytes();
+            nodos += reader.getNodes().size();
+        }
+    }
+    auto t2 = high_resolution_clock::now();
+
+    double segundos = duration<double>(t2 - t1).count();
+    cout << fixed << setprecision(2);
+    cout << "Archivos: " << archivos.size() << " x " << repeticiones
+         << " | MB: " << bytes / 1e6
+         << " | Tiempo: " << segundos * 1e3 << " ms"
+         << " | Throughput: " << bytes / 1e6 / segundos << " MB/s"
+         << " | Nodos/s: " << nodos / segundos << "\n";
+    return 0;
+}
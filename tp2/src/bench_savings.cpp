@@ -0,0 +1,79 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "VRPLIBReader.h"
+#include "InstanceView.h"
+#include "NeighborIndex.h"
+#include "clarkewright.h"
+
+using namespace std;
+using namespace std::chrono;
+namespace fs = std::filesystem;
+
+// Compara Clarke-Wright disperso (ahorros solo entre vecinos cercanos) con el
+// denso: brecha de costo, tiempo, y "recall", la fracción de aristas
+// cliente-cliente de la solución densa cuyo par está entre los candidatos.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Uso: " << argv[0] << " <archivo.dat | directorio> [k1 k2 ...]\n";
+        return 1;
+    }
+
+    vector<string> archivos = listInstanceFiles(argv[1]);
+    vector<int> ks;
+    for (int a = 2; a < argc; ++a) ks.push_back(stoi(argv[a]));
+    if (ks.empty()) ks = {10, 20, 40};
+
+    vector<double> brecha_total(ks.size(), 0.0), recall_total(ks.size(), 0.0);
+    cout << fixed << setprecision(2);
+    for (const string& archivo : archivos) {
+        VRPLIBReader reader(archivo);
+        InstanceView instancia(reader);
+        const DistanceMatrix& d = reader.getDistanceMatrix();
+
+        auto t1 = high_resolution_clock::now();
+        auto densas = clarkewright(instancia);
+        auto t2 = high_resolution_clock::now();
+        double costo_denso = instancia.totalCost(densas);
+        cout << fs::path(archivo).filename().string()
+             << " | n: " << instancia.size()
+             << " | Denso: " << costo_denso << " (" << duration<double, milli>(t2 - t1).count() << " ms)";
+
+        for (size_t q = 0; q < ks.size(); ++q) {
+            NeighborIndex vecinos(d, ks[q], reader.getDepotId());
+            t1 = high_resolution_clock::now();
+            auto dispersas = clarkewright(instancia, vecinos);
+            t2 = high_resolution_clock::now();
+            double brecha = 100.0 * (instancia.totalCost(dispersas) - costo_denso) / costo_denso;
+
+            auto esVecino = [&](int a, int b) {
+                for (int v : vecinos.neighbors(a)) if (v == b) return true;
+                return false;
+            };
+            int aristas = 0, cubiertas = 0;
+            for (const auto& ruta : densas) {
+                for (size_t i = 1; i + 2 < ruta.size(); ++i) {
+                    ++aristas;
+                    if (esVecino(ruta[i], ruta[i + 1]) || esVecino(ruta[i + 1], ruta[i])) ++cubiertas;
+                }
+            }
+            double recall = aristas > 0 ? 100.0 * cubiertas / aristas : 100.0;
+            brecha_total[q] += brecha;
+            recall_total[q] += recall;
+
+            cout << " | k=" << vecinos.getK() << ": " << brecha << "% recall " << recall
+                 << "% (" << duration<double, milli>(t2 - t1).count() << " ms)";
+        }
+        cout << "\n";
+    }
+
+    for (size_t q = 0; q < ks.size(); ++q) {
+        cout << "Promedio k=" << ks[q] << " | Brecha: " << brecha_total[q] / archivos.size()
+             << "% | Recall: " << recall_total[q] / archivos.size() << "%\n";
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include "VRPLIBReader.h"
+#include "InstanceView.h"
+#include "armarRutasCortas.h"
+#include "split.h"
+
+using namespace std;
+using namespace std::chrono;
+namespace fs = std::filesystem;
+
+// Mide el throughput de Split (tours/s) sobre un archivo o un directorio de
+// instancias: decodifica tours aleatorios con flota ilimitada y acotada. Como
+// control, el split del tour de Rutas Cortas no puede costar más que ellas.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Uso: " << argv[0] << " <archivo.dat | directorio> [tours]\n";
+        return 1;
+    }
+
+    vector<string> archivos = listInstanceFiles(argv[1]);
+    int cantidad = argc >= 3 ? stoi(argv[2]) : 1000;
+
+    cout << fixed << setprecision(2);
+    for (const string& archivo : archivos) {
+        VRPLIBReader reader(archivo);
+        InstanceView instancia(reader);
+        Split split(instancia);
+        vector<vector<int>> rutas;
+
+        auto cortas = armarRutasCortas(instancia);
+        double costo_cortas = instancia.totalCost(cortas);
+        double costo_split = split.dividir(tourGigante(cortas), rutas);
+
+        mt19937 gen(1);
+        vector<vector<int>> tours(cantidad, tourGigante(cortas));
+        for (auto& tour : tours) shuffle(tour.begin(), tour.end(), gen);
+
+        double suma = 0.0;
+        auto t1 = high_resolution_clock::now();
+        for (const auto& tour : tours) suma += split.dividir(tour, rutas);
+        auto t2 = high_resolution_clock::now();
+        double libre = duration<double>(t2 - t1).count();
+
+        int vehiculos = reader.getNumVehicles();
+        int acotados = 0;
+        t1 = high_resolution_clock::now();
+        for (const auto& tour : tours) {
+            if (split.dividir(tour, vehiculos, rutas) < Split::INFACTIBLE) ++acotados;
+        }
+        t2 = high_resolution_clock::now();
+        double acotado = duration<double>(t2 - t1).count();
+
+        cout << fs::path(archivo).filename().string()
+             << " | n: " << instancia.size() - 1
+             << " | Rutas Cortas: " << costo_cortas << " -> split " << costo_split
+             << (costo_split <= costo_cortas + 1e-6 ? "" : " (!)")
+             << " | Aleatorio medio: " << suma / cantidad
+             << " | Ilimitada: " << cantidad / libre << " tours/s"
+             << " | K=" << vehiculos << ": " << cantidad / acotado << " tours/s ("
+             << acotados << "/" << cantidad << " factibles)\n";
+    }
+    return 0;
+}
@@ -1,113 +1,624 @@
 #include "busqueda_local.h"
+#include "Trace.h"
 #include <vector>
 #include <algorithm>
 #include <iostream>
 
 using namespace std;
 
-double calcularDistanciaRuta(const vector<int>& ruta, const vector<vector<double>>& distancias) {
+double calcularDistanciaRuta(const vector<int>& ruta, const DistanceMatrix& distancias) {
     double total = 0.0;
     for (size_t i = 0; i < ruta.size() - 1; ++i) {
-        total += distancias[ruta[i]][ruta[i + 1]];
+        total += distancias(ruta[i], ruta[i + 1]);
     }
     return total;
 }
 
 
+// Tolerancia para aceptar un movimiento: evita ciclar por errores de redondeo
+const double EPS_MEJORA = 1e-9;
+
+EstadoRutas::EstadoRutas(const vector<vector<int>>& rutas_iniciales, const ContextoBusqueda& ctx)
+    : rutas(rutas_iniciales),
+      carga(rutas_iniciales.size(), 0),
+      carga_acum(rutas_iniciales.size()),
+      costo(rutas_iniciales.size(), 0.0),
+      ruta_de(ctx.distancias.size(), -1),
+      pos_de(ctx.distancias.size(), -1),
+      mirar(ctx.distancias.size(), 1) {
+    for (size_t r = 0; r < rutas.size(); ++r) {
+        costo[r] = calcularDistanciaRuta(rutas[r], ctx.distancias);
+        recalcularCargas(r, 0, ctx.demandas);
+        reindexar(r, 1, rutas[r].size() - 1);
+    }
+}
+
+void EstadoRutas::reindexar(int r, size_t desde, size_t hasta) {
+    const vector<int>& ruta = rutas[r];
+    for (size_t i = desde; i < hasta; ++i) {
+        ruta_de[ruta[i]] = r;
+        pos_de[ruta[i]] = i;
+    }
+}
+
+void EstadoRutas::recalcularCargas(int r, size_t desde, const vector<int>& demandas) {
+    const vector<int>& ruta = rutas[r];
+    vector<int>& acum = carga_acum[r];
+    acum.resize(ruta.size());
+    int total = desde > 0 ? acum[desde - 1] : 0;
+    for (size_t i = desde; i < ruta.size(); ++i) {
+        total += demandas[ruta[i]];
+        acum[i] = total;
+    }
+    carga[r] = total;
+}
+
+void EstadoRutas::eliminarRutasVacias() {
+    size_t k = 0;
+    for (size_t r = 0; r < rutas.size(); ++r) {
+        if (rutas[r].size() <= 2) continue;  // Solo ida y vuelta al depósito
+        if (k != r) {
+            rutas[k] = move(rutas[r]);
+            carga[k] = carga[r];
+            carga_acum[k] = move(carga_acum[r]);
+            costo[k] = costo[r];
+            reindexar(k, 1, rutas[k].size() - 1);
+        }
+        ++k;
+    }
+    rutas.resize(k);
+    carga.resize(k);
+    carga_acum.resize(k);
+    costo.resize(k);
+}
+
+void EstadoRutas::marcar(int nodo) {
+    mirar[nodo] = 1;
+}
+
+double EstadoRutas::costoTotal() const {
+    double total = 0.0;
+    for (double c : costo) total += c;
+    return total;
+}
+
+// Intercambia el cliente u = rutas[r1][i] con v = rutas[r2][j] (r1 != r2).
+// Solo cambian las cuatro aristas que tocan a u y a v, así que la variación
+// de costo se calcula en O(1) y la factibilidad con las cargas cacheadas.
+double mejorarSwap(EstadoRutas& estado, const ContextoBusqueda& ctx) {
+    const DistanceMatrix& d = ctx.distancias;
+    auto& rutas = estado.rutas;
+    double total = 0.0;
+
+    // Variación de costo en cada ruta; false si el intercambio no es factible
+    auto evaluar = [&](int r1, size_t i, int r2, size_t j, double& delta1, double& delta2) {
+        estado.contarEvaluado();
+        int u = rutas[r1][i];
+        int v = rutas[r2][j];
+        int qu = ctx.demandas[u];
+        int qv = ctx.demandas[v];
+        if (estado.carga[r1] - qu + qv > ctx.capacidad ||
+            estado.carga[r2] - qv + qu > ctx.capacidad) {
+            return false;
+        }
+        int a = rutas[r1][i - 1], b = rutas[r1][i + 1];
+        int c = rutas[r2][j - 1], e = rutas[r2][j + 1];
+        delta1 = d(a, v) + d(v, b) - d(a, u) - d(u, b);
+        delta2 = d(c, u) + d(u, e) - d(c, v) - d(v, e);
+        return true;
+    };
+
+    auto aplicar = [&](int r1, size_t i, int r2, size_t j, double delta1, double delta2) {
+        int u = rutas[r1][i];
+        int v = rutas[r2][j];
+        swap(rutas[r1][i], rutas[r2][j]);
+        estado.recalcularCargas(r1, i, ctx.demandas);
+        estado.recalcularCargas(r2, j, ctx.demandas);
+        estado.costo[r1] += delta1;
+        estado.costo[r2] += delta2;
+        estado.ruta_de[v] = r1;
+        estado.pos_de[v] = i;
+        estado.ruta_de[u] = r2;
+        estado.pos_de[u] = j;
+        for (int nodo : {rutas[r1][i - 1], v, rutas[r1][i + 1],
+                         rutas[r2][j - 1], u, rutas[r2][j + 1]}) {
+            estado.marcar(nodo);
+        }
+        total += delta1 + delta2;
+    };
+
+    // Recorre los candidatos de rutas[r1][i]: sus vecinos o todas las demás rutas.
+    // `probar` devuelve true si u cambió de ruta (hay que pasar al siguiente).
+    auto recorrer = [&](auto&& probar) {
+        int R = rutas.size();
+        for (int r1 = 0; r1 < R; ++r1) {
+            for (size_t i = 1; i + 1 < rutas[r1].size(); ++i) {
+                if (ctx.vecinos != nullptr) {
+                    int u = rutas[r1][i];
+                    for (int v : ctx.vecinos->neighbors(u)) {
+                        int r2 = estado.ruta_de[v];
+                        if (r2 < 0 || r2 == r1) continue;
+                        if (probar(r1, i, r2, static_cast<size_t>(estado.pos_de[v]))) break;
+                    }
+                    continue;
+                }
+                for (int r2 = 0; r2 < R; ++r2) {
+                    if (r1 == r2) continue;  // Solo entre rutas distintas
+                    for (size_t j = 1; j + 1 < rutas[r2].size(); ++j) {
+                        probar(r1, i, r2, j);
+                    }
+                }
+            }
+        }
+    };
+
+    bool hayMejora = true;
+    while (hayMejora) {
+        hayMejora = false;
+
+        if (ctx.modo == ModoBusqueda::PrimeraMejora) {
+            recorrer([&](int r1, size_t i, int r2, size_t j) {
+                double delta1, delta2;
+                if (evaluar(r1, i, r2, j, delta1, delta2) && delta1 + delta2 < -EPS_MEJORA) {
+                    aplicar(r1, i, r2, j, delta1, delta2);
+                    hayMejora = true;
+                    return true;
+                }
+                return false;
+            });
+        } else {
+            double mejor = -EPS_MEJORA;
+            int m_r1 = -1, m_r2 = -1;
+            size_t m_i = 0, m_j = 0;
+            double m_d1 = 0.0, m_d2 = 0.0;
+            recorrer([&](int r1, size_t i, int r2, size_t j) {
+                double delta1, delta2;
+                if (evaluar(r1, i, r2, j, delta1, delta2) && delta1 + delta2 < mejor) {
+                    mejor = delta1 + delta2;
+                    m_r1 = r1; m_i = i; m_r2 = r2; m_j = j;
+                    m_d1 = delta1; m_d2 = delta2;
+                }
+                return false;
+            });
+            if (m_r1 >= 0) {
+                aplicar(m_r1, m_i, m_r2, m_j, m_d1, m_d2);
+                hayMejora = true;
+            }
+        }
+    }
+
+    return total;
+}
+
 vector<vector<int>> BusquedaLocalSwap(
     const vector<vector<int>>& rutas,
-    const vector<vector<double>>& distancias,
+    const DistanceMatrix& distancias,
     const vector<int>& demandas,
-    int capacidad
+    int capacidad,
+    const NeighborIndex* vecinos,
+    ModoBusqueda modo
 ) {
-    vector<vector<int>> mejor_rutas = rutas;
-    bool hayMejora = true;
+    TRACE_SCOPE("BusquedaLocalSwap");
+    ContextoBusqueda ctx{distancias, demandas, capacidad, vecinos, modo};
+    EstadoRutas estado(rutas, ctx);
+    mejorarSwap(estado, ctx);
+    return estado.rutas;
+}
+
+// Movimiento de una cadena de `largo` clientes, rutas[r1][i .. i+largo-1],
+// a la ruta r2 delante de la posición j (opcionalmente invertida)
+struct MovCadena {
+    int r1;
+    size_t i;
+    int largo;
+    int r2;
+    size_t j;
+    bool invertida;
+    double delta1;   // variación de costo en r1 (sin las aristas internas)
+    double delta2;   // variación de costo en r2 (sin las aristas internas)
+};
+
+// Relocate (largo 1) y Or-opt (largo 2-3) entre rutas distintas. Sacar la
+// cadena cambia tres aristas de r1 y meterla tres de r2, así que cada
+// movimiento se evalúa en O(1), y la demanda de la cadena sale de las cargas
+// acumuladas.
+// Las rutas que quedan vacías se eliminan al terminar.
+static double moverCadenas(EstadoRutas& estado, const ContextoBusqueda& ctx,
+                           int largo_min, int largo_max) {
+    const DistanceMatrix& d = ctx.distancias;
+    auto& rutas = estado.rutas;
+    double total = 0.0;
 
-    auto calcularCarga = [&](const vector<int>& ruta) {
-        int carga = 0;
-        for (int cliente : ruta) {
-            if (cliente != 0) carga += demandas[cliente];
+    auto aplicar = [&](const MovCadena& mov) {
+        vector<int>& origen = rutas[mov.r1];
+        vector<int>& destino = rutas[mov.r2];
+        auto ini = origen.begin() + mov.i;
+        auto fin = ini + mov.largo;
+
+        // Las aristas internas de la cadena pasan de r1 a r2 sin cambiar
+        double interno = 0.0;
+        for (auto it = ini; it != fin; ++it) {
+            if (it + 1 != fin) interno += d(*it, *(it + 1));
+            estado.marcar(*it);
         }
-        return carga;
+        estado.marcar(origen[mov.i - 1]);
+        estado.marcar(*fin);
+        estado.marcar(destino[mov.j - 1]);
+        estado.marcar(destino[mov.j]);
+
+        destino.insert(destino.begin() + mov.j, ini, fin);
+        if (mov.invertida) {
+            reverse(destino.begin() + mov.j, destino.begin() + mov.j + mov.largo);
+        }
+        origen.erase(ini, fin);
+        estado.reindexar(mov.r1, mov.i, origen.size() - 1);
+        estado.reindexar(mov.r2, mov.j, destino.size() - 1);
+
+        estado.recalcularCargas(mov.r1, mov.i, ctx.demandas);
+        estado.recalcularCargas(mov.r2, mov.j, ctx.demandas);
+        estado.costo[mov.r1] += mov.delta1 - interno;
+        estado.costo[mov.r2] += mov.delta2 + interno;
+        total += mov.delta1 + mov.delta2;
+    };
+
+    // Evalúa todas las inserciones de la cadena rutas[r1][i..] de ese largo.
+    // `probar` devuelve true si aplicó el movimiento (hay que pasar al siguiente).
+    auto evaluarCadena = [&](int r1, size_t i, int largo, auto&& probar) {
+        const vector<int>& origen = rutas[r1];
+        int primero = origen[i];
+        int ultimo = origen[i + largo - 1];
+        int antes = origen[i - 1];
+        int despues = origen[i + largo];
+        const vector<int>& acum = estado.carga_acum[r1];
+        int carga_cadena = acum[i + largo - 1] - acum[i - 1];
+        double quitar = d(antes, despues) - d(antes, primero) - d(ultimo, despues);
+
+        // Inserción entre rutas[r2][j-1] y rutas[r2][j], en los dos sentidos
+        auto probarPosicion = [&](int r2, size_t j) {
+            int a = rutas[r2][j - 1], b = rutas[r2][j];
+            double base = d(a, b);
+            MovCadena mov{r1, i, largo, r2, j, false, quitar, d(a, primero) + d(ultimo, b) - base};
+            estado.contarEvaluado();
+            if (probar(mov)) return true;
+            if (largo > 1) {
+                estado.contarEvaluado();
+                mov.invertida = true;
+                mov.delta2 = d(a, ultimo) + d(primero, b) - base;
+                if (probar(mov)) return true;
+            }
+            return false;
+        };
+
+        if (ctx.vecinos != nullptr) {
+            // Solo inserciones que dejan al primero de la cadena junto a un vecino
+            for (int v : ctx.vecinos->neighbors(primero)) {
+                int r2 = estado.ruta_de[v];
+                if (r2 < 0 || r2 == r1) continue;
+                if (estado.carga[r2] + carga_cadena > ctx.capacidad) continue;
+                size_t j = estado.pos_de[v];
+                if (probarPosicion(r2, j) || probarPosicion(r2, j + 1)) return true;
+            }
+            return false;
+        }
+
+        for (int r2 = 0; r2 < static_cast<int>(rutas.size()); ++r2) {
+            if (r2 == r1 || estado.carga[r2] + carga_cadena > ctx.capacidad) continue;
+            for (size_t j = 1; j < rutas[r2].size(); ++j) {
+                if (probarPosicion(r2, j)) return true;
+            }
+        }
+        return false;
     };
 
+    auto recorrer = [&](auto&& probar) {
+        for (int r1 = 0; r1 < static_cast<int>(rutas.size()); ++r1) {
+            for (size_t i = 1; i + 1 < rutas[r1].size(); ++i) {
+                for (int largo = largo_min; largo <= largo_max && i + largo < rutas[r1].size(); ++largo) {
+                    if (evaluarCadena(r1, i, largo, probar)) break;
+                }
+            }
+        }
+    };
+
+    bool hayMejora = true;
     while (hayMejora) {
         hayMejora = false;
 
-        for (size_t r1 = 0; r1 < mejor_rutas.size(); ++r1) {
-            for (size_t i = 1; i < mejor_rutas[r1].size() - 1; ++i) {
-                for (size_t r2 = 0; r2 < mejor_rutas.size(); ++r2) {
-                    if (r1 == r2) continue;  // Solo entre rutas distintas
+        if (ctx.modo == ModoBusqueda::PrimeraMejora) {
+            recorrer([&](const MovCadena& mov) {
+                if (mov.delta1 + mov.delta2 < -EPS_MEJORA) {
+                    aplicar(mov);
+                    hayMejora = true;
+                    return true;
+                }
+                return false;
+            });
+        } else {
+            MovCadena mejor{-1, 0, 0, -1, 0, false, 0.0, -EPS_MEJORA};
+            recorrer([&](const MovCadena& mov) {
+                if (mov.delta1 + mov.delta2 < mejor.delta1 + mejor.delta2) mejor = mov;
+                return false;
+            });
+            if (mejor.r1 >= 0) {
+                aplicar(mejor);
+                hayMejora = true;
+            }
+        }
+    }
 
-                    for (size_t j = 1; j < mejor_rutas[r2].size() - 1; ++j) {
-                        // Copiar rutas para testeo
-                        vector<int> nueva_ruta1 = mejor_rutas[r1];
-                        vector<int> nueva_ruta2 = mejor_rutas[r2];
+    estado.eliminarRutasVacias();
+    return total;
+}
+
+double mejorarRelocate(EstadoRutas& estado, const ContextoBusqueda& ctx) {
+    return moverCadenas(estado, ctx, 1, 1);
+}
+
+double mejorarOrOpt(EstadoRutas& estado, const ContextoBusqueda& ctx) {
+    return moverCadenas(estado, ctx, 2, 3);
+}
 
-                        swap(nueva_ruta1[i], nueva_ruta2[j]);
+vector<vector<int>> BusquedaLocalRelocate(
+    const vector<vector<int>>& rutas,
+    const DistanceMatrix& distancias,
+    const vector<int>& demandas,
+    int capacidad,
+    const NeighborIndex* vecinos,
+    ModoBusqueda modo
+) {
+    ContextoBusqueda ctx{distancias, demandas, capacidad, vecinos, modo};
+    EstadoRutas estado(rutas, ctx);
+    mejorarRelocate(estado, ctx);
+    return move(estado.rutas);
+}
 
-                        // Validar factibilidad
-                        if (calcularCarga(nueva_ruta1) <= capacidad &&
-                            calcularCarga(nueva_ruta2) <= capacidad) {
+vector<vector<int>> BusquedaLocalOrOpt(
+    const vector<vector<int>>& rutas,
+    const DistanceMatrix& distancias,
+    const vector<int>& demandas,
+    int capacidad,
+    const NeighborIndex* vecinos,
+    ModoBusqueda modo
+) {
+    ContextoBusqueda ctx{distancias, demandas, capacidad, vecinos, modo};
+    EstadoRutas estado(rutas, ctx);
+    mejorarOrOpt(estado, ctx);
+    return move(estado.rutas);
+}
 
-                            double dist_original = calcularDistanciaRuta(mejor_rutas[r1], distancias) +
-                                                   calcularDistanciaRuta(mejor_rutas[r2], distancias);
-                            double nueva_dist = calcularDistanciaRuta(nueva_ruta1, distancias) +
-                                                calcularDistanciaRuta(nueva_ruta2, distancias);
+// 2-opt* entre las rutas r1 y r2: corta r1 después de la posición i y r2
+// después de la j, e intercambia las colas. Quita (a, b) = (r1[i], r1[i+1]) y
+// (c, e) = (r2[j], r2[j+1]) y agrega (a, e) y (c, b). Con las cargas
+// acumuladas la factibilidad es O(1): la nueva r1 carga acum1[i] más la cola
+// de r2, y viceversa.
+double mejorar2optEstrella(EstadoRutas& estado, const ContextoBusqueda& ctx) {
+    const DistanceMatrix& d = ctx.distancias;
+    auto& rutas = estado.rutas;
+    double total = 0.0;
 
-                            if (nueva_dist < dist_original) {
-                                mejor_rutas[r1] = nueva_ruta1;
-                                mejor_rutas[r2] = nueva_ruta2;
-                                hayMejora = true;
-                            }
-                        }
+    struct Corte {
+        int r1;
+        size_t i;
+        int r2;
+        size_t j;
+        double delta;
+    };
+
+    // Variación de costo del corte; false si alguna ruta se pasa de capacidad
+    auto evaluar = [&](int r1, size_t i, int r2, size_t j, double& delta) {
+        estado.contarEvaluado();
+        int cabeza1 = estado.carga_acum[r1][i];
+        int cabeza2 = estado.carga_acum[r2][j];
+        if (cabeza1 + estado.carga[r2] - cabeza2 > ctx.capacidad ||
+            cabeza2 + estado.carga[r1] - cabeza1 > ctx.capacidad) {
+            return false;
+        }
+        int a = rutas[r1][i], b = rutas[r1][i + 1];
+        int c = rutas[r2][j], e = rutas[r2][j + 1];
+        delta = d(a, e) + d(c, b) - d(a, b) - d(c, e);
+        return true;
+    };
+
+    auto aplicar = [&](const Corte& mov) {
+        vector<int>& ruta1 = rutas[mov.r1];
+        vector<int>& ruta2 = rutas[mov.r2];
+        for (int nodo : {ruta1[mov.i], ruta1[mov.i + 1], ruta2[mov.j], ruta2[mov.j + 1]}) {
+            estado.marcar(nodo);
+        }
+
+        vector<int> cola1(ruta1.begin() + mov.i + 1, ruta1.end());
+        ruta1.resize(mov.i + 1);
+        ruta1.insert(ruta1.end(), ruta2.begin() + mov.j + 1, ruta2.end());
+        ruta2.resize(mov.j + 1);
+        ruta2.insert(ruta2.end(), cola1.begin(), cola1.end());
+
+        estado.reindexar(mov.r1, mov.i + 1, ruta1.size() - 1);
+        estado.reindexar(mov.r2, mov.j + 1, ruta2.size() - 1);
+        estado.recalcularCargas(mov.r1, mov.i + 1, ctx.demandas);
+        estado.recalcularCargas(mov.r2, mov.j + 1, ctx.demandas);
+        // El reparto del delta entre las dos rutas depende de las colas
+        estado.costo[mov.r1] = calcularDistanciaRuta(ruta1, d);
+        estado.costo[mov.r2] = calcularDistanciaRuta(ruta2, d);
+        total += mov.delta;
+    };
+
+    // `probar` devuelve true si aplicó el movimiento (hay que pasar al siguiente)
+    auto recorrer = [&](auto&& probar) {
+        int R = rutas.size();
+        for (int r1 = 0; r1 < R; ++r1) {
+            for (size_t i = 0; i + 1 < rutas[r1].size(); ++i) {
+                if (ctx.vecinos != nullptr) {
+                    // Cortes que crean una arista (u, v) con v en la lista de u:
+                    // u = a y v = e, o u = b y v = c
+                    if (i == 0) continue;
+                    int u = rutas[r1][i];
+                    for (int v : ctx.vecinos->neighbors(u)) {
+                        int r2 = estado.ruta_de[v];
+                        if (r2 < 0 || r2 == r1) continue;
+                        size_t j = estado.pos_de[v];
+                        if (probar(r1, i, r2, j - 1) || probar(r1, i - 1, r2, j)) break;
+                    }
+                    continue;
+                }
+                for (int r2 = r1 + 1; r2 < R; ++r2) {
+                    for (size_t j = 0; j + 1 < rutas[r2].size(); ++j) {
+                        if (probar(r1, i, r2, j)) break;
                     }
                 }
             }
         }
+    };
+
+    bool hayMejora = true;
+    while (hayMejora) {
+        hayMejora = false;
+
+        if (ctx.modo == ModoBusqueda::PrimeraMejora) {
+            recorrer([&](int r1, size_t i, int r2, size_t j) {
+                double delta;
+                if (evaluar(r1, i, r2, j, delta) && delta < -EPS_MEJORA) {
+                    aplicar(Corte{r1, i, r2, j, delta});
+                    hayMejora = true;
+                    return true;
+                }
+                return false;
+            });
+        } else {
+            Corte mejor{-1, 0, -1, 0, -EPS_MEJORA};
+            recorrer([&](int r1, size_t i, int r2, size_t j) {
+                double delta;
+                if (evaluar(r1, i, r2, j, delta) && delta < mejor.delta) {
+                    mejor = Corte{r1, i, r2, j, delta};
+                }
+                return false;
+            });
+            if (mejor.r1 >= 0) {
+                aplicar(mejor);
+                hayMejora = true;
+            }
+        }
     }
 
-    return mejor_rutas;
+    estado.eliminarRutasVacias();
+    return total;
 }
 
+vector<vector<int>> BusquedaLocal2optEstrella(
+    const vector<vector<int>>& rutas,
+    const DistanceMatrix& distancias,
+    const vector<int>& demandas,
+    int capacidad,
+    const NeighborIndex* vecinos,
+    ModoBusqueda modo
+) {
+    ContextoBusqueda ctx{distancias, demandas, capacidad, vecinos, modo};
+    EstadoRutas estado(rutas, ctx);
+    mejorar2optEstrella(estado, ctx);
+    return move(estado.rutas);
+}
 
 
 
-vector<int> aplicar2opt(const vector<int>& ruta, const vector<vector<double>>& distancias) {
-    vector<int> mejor_ruta = ruta;
-    bool mejora = true;
 
-    while (mejora) {
-        mejora = false;
-        double mejor_dist = calcularDistanciaRuta(mejor_ruta, distancias);
+// Busca en la ruta r reversiones r[i..j] que mejoren y las aplica en el lugar.
+// Una reversión quita las aristas (a, b) = (r[i-1], r[i]) y (c, e) = (r[j], r[j+1])
+// y agrega (a, c) y (b, e); el resto de la ruta no cambia de costo (distancias
+// simétricas), así que la ganancia se calcula en O(1).
+// Solo se procesan los clientes con su bit de "mirar" encendido; al no
+// encontrar mejora desde un cliente se apaga, y se vuelve a encender cuando
+// cambia alguna de sus aristas.
+static double mejorar2optRuta(EstadoRutas& estado, const ContextoBusqueda& ctx, int r,
+                              vector<int>& cola) {
+    const DistanceMatrix& d = ctx.distancias;
+    vector<int>& ruta = estado.rutas[r];
+    const int m = ruta.size();
+    double total = 0.0;
+
+    // Reversión que usa las aristas p = (r[p], r[p+1]) y q = (r[q], r[q+1]).
+    // Devuelve true si mejoraba y se aplicó.
+    auto probar = [&](int p, int q) {
+        if (p > q) swap(p, q);
+        if (p < 0 || q > m - 2 || q < p + 2) return false;
+        estado.contarEvaluado();
+        int a = ruta[p], b = ruta[p + 1];
+        int c = ruta[q], e = ruta[q + 1];
+        double delta = d(a, c) + d(b, e) - d(a, b) - d(c, e);
+        if (delta >= -EPS_MEJORA) return false;
+
+        reverse(ruta.begin() + p + 1, ruta.begin() + q + 1);
+        estado.reindexar(r, p + 1, q + 1);
+        estado.recalcularCargas(r, p + 1, ctx.demandas);
+        estado.costo[r] += delta;
+        total += delta;
+        for (int nodo : {a, b, c, e}) {
+            if (estado.ruta_de[nodo] >= 0 && !estado.mirar[nodo]) {
+                estado.mirar[nodo] = 1;
+                cola.push_back(nodo);
+            }
+        }
+        return true;
+    };
 
-        for (size_t i = 1; i < mejor_ruta.size() - 2; ++i) {
-            for (size_t j = i + 1; j < mejor_ruta.size() - 1; ++j) {
-                vector<int> nueva_ruta = mejor_ruta;
-                reverse(nueva_ruta.begin() + i, nueva_ruta.begin() + j + 1);
+    cola.clear();
+    for (int k = 1; k + 1 < m; ++k) {
+        if (estado.mirar[ruta[k]]) cola.push_back(ruta[k]);
+    }
 
-                double nueva_dist = calcularDistanciaRuta(nueva_ruta, distancias);
-                if (nueva_dist < mejor_dist) {
-                    mejor_ruta = nueva_ruta;
-                    mejor_dist = nueva_dist;
-                    mejora = true;
+    for (size_t k = 0; k < cola.size(); ++k) {
+        int u = cola[k];
+        if (!estado.mirar[u]) continue;
+        estado.mirar[u] = 0;
+
+        bool mejoro = false;
+        int s = estado.pos_de[u];
+        if (ctx.vecinos != nullptr) {
+            // Solo reversiones que crean una arista (u, v) con v en la lista de u:
+            // como (a, c) o como (b, e), según quién quede antes en la ruta
+            for (int v : ctx.vecinos->neighbors(u)) {
+                if (estado.ruta_de[v] != r) continue;
+                int t = estado.pos_de[v];
+                int lo = min(s, t), hi = max(s, t);
+                if (probar(lo, hi) || probar(lo - 1, hi - 1)) {
+                    mejoro = true;
+                    break;
                 }
             }
+        } else {
+            // Cada arista de u contra todas las demás aristas de la ruta
+            for (int q = 0; q + 1 < m && !mejoro; ++q) {
+                mejoro = probar(s, q) || probar(s - 1, q);
+            }
+        }
+        if (mejoro && !estado.mirar[u]) {
+            estado.mirar[u] = 1;
+            cola.push_back(u);
         }
     }
 
-    return mejor_ruta;
+    return total;
+}
+
+double mejorar2opt(EstadoRutas& estado, const ContextoBusqueda& ctx) {
+    vector<int> cola;
+    double total = 0.0;
+    for (size_t r = 0; r < estado.rutas.size(); ++r) {
+        total += mejorar2optRuta(estado, ctx, r, cola);
+    }
+    return total;
 }
 
 vector<vector<int>> busquedaLocal2opt(
     const vector<vector<int>>& rutas,
-    const vector<vector<double>>& distancias
+    const DistanceMatrix& distancias,
+    const NeighborIndex* vecinos
 ) {
-    vector<vector<int>> resultado;
-    for (const auto& ruta : rutas) {
-        resultado.push_back(aplicar2opt(ruta, distancias));
-    }
-    return resultado;
+    TRACE_SCOPE("busquedaLocal2opt");
+    // El 2-opt intra-ruta no cambia las cargas, así que no necesita demandas
+    const vector<int> sin_demandas(distancias.size(), 0);
+    ContextoBusqueda ctx{distancias, sin_demandas, 0, vecinos};
+    EstadoRutas estado(rutas, ctx);
+    mejorar2opt(estado, ctx);
+    return move(estado.rutas);
 }
 
 /*
@@ -121,41 +632,73 @@ Sea:
 - n = cantidad total de nodos (para referencia global)
 
 -----------------------------------------------------------
-1. busquedaLocalSwap(...)
+1. busquedaLocalSwap(...) / mejorarSwap(...)
 -----------------------------------------------------------
 
-Para cada ruta:
-- Se considera cada par de posiciones (i, j) dentro de la ruta: O(m²)
-- Para cada swap se recalcula la distancia de la ruta: O(m)
-- Se repite mientras haya mejora (puede ser varias iteraciones)
+- Se considera cada par de clientes (u, v) en rutas distintas: O(n²) pares
+- Cada swap se evalúa en O(1): cuatro aristas y las cargas cacheadas por ruta
+- Solo se modifica el estado (en el lugar) cuando el movimiento se acepta
+- Se repite mientras haya mejora (k pasadas)
 
-Peor caso por ruta: O(k × m³), donde k es la cantidad de iteraciones hasta converger
+Total: O(k × n²) en modo completo. En mejor mejora cada pasada aplica un
+solo movimiento, así que k suele ser mayor que en primera mejora.
 
-Total para todas las rutas: O(r × k × m³)
+-----------------------------------------------------------
+2. mejorar2opt(...) / busquedaLocal2opt(...)
+-----------------------------------------------------------
 
-En la práctica, k es pequeño y m ≪ n, así que el algoritmo es eficiente para rutas cortas.
+Para una sola ruta:
+- Cada cliente con su bit de "mirar" encendido prueba sus dos aristas contra
+  las demás aristas de la ruta → O(m) reversiones por cliente
+- Cada reversión se evalúa en O(1) (cuatro aristas) y solo la que se aplica
+  cuesta O(m): se invierte el segmento en el lugar y se reindexa
+- Los clientes sin mejora apagan su bit y no se vuelven a mirar hasta que
+  cambie alguna de sus aristas (también entre llamadas, vía EstadoRutas)
+
+Complejidad por ruta: O(m²) por pasada completa más O(m) por movimiento
+aplicado, en vez del O(k × m³) de recalcular la ruta en cada candidato.
 
 -----------------------------------------------------------
-2. aplicar2opt(...)
+3. mejorarRelocate(...) / mejorarOrOpt(...)
 -----------------------------------------------------------
 
-Para una sola ruta:
-- Se consideran pares (i, j) donde 1 ≤ i < j ≤ m-2 → O(m²)
-- Cada reversa de segmento es O(m), y se recalcula la distancia: O(m)
-- Se repite hasta no mejorar → multiplicado por k iteraciones
+- Cada cadena (n × L cadenas, L ≤ 3) prueba cada posición de las otras rutas
+  en los dos sentidos: O(n) inserciones, cada una evaluada en O(1)
+- Aplicar un movimiento cuesta O(m) (borrar, insertar y reindexar)
 
-Complejidad por ruta: O(k × m³)
+Total: O(k × L × n²) en modo completo.
 
 -----------------------------------------------------------
-3. busquedaLocal2opt(...)
+4. mejorar2optEstrella(...)
 -----------------------------------------------------------
 
-Llama a aplicar2opt(...) sobre cada ruta → O(r × k × m³)
+- Se prueba cada par de cortes (i en r1, j en r2): O(n²) pares
+- Cada corte se evalúa en O(1): dos aristas quitadas, dos agregadas, y las
+  cargas de las rutas nuevas salen de carga_acum
+- Aplicar intercambia las colas y actualiza índices y cargas: O(m)
+
+Total: O(k × n²) en modo completo.
 
 -----------------------------------------------------------
 Resumen:
-- Complejidad temporal Swap:      O(r × k × m³)
-- Complejidad temporal 2-opt:     O(r × k × m³)
+- Complejidad temporal Swap:      O(k × n²)
+- Complejidad temporal 2-opt:     O(r × m²) por pasada
+- Complejidad Relocate / Or-opt:  O(k × L × n²)
+- Complejidad temporal 2-opt*:    O(k × n²)
+
+-----------------------------------------------------------
+5. Modo granular (con lista de K vecinos más cercanos)
+-----------------------------------------------------------
+
+En lugar de todos los pares, cada cliente prueba solo sus K vecinos, ubicados
+en O(1) con los arreglos ruta_de / pos_de:
+- Swap:  O(n × K) evaluaciones por pasada, en vez de O(n²)
+- 2-opt: O(m × K) evaluaciones por ruta y pasada, en vez de O(m²); cada
+  vecino v de u prueba las dos reversiones que crean la arista (u, v)
+- Relocate / Or-opt: cada cadena se prueba solo antes y después de los
+  vecinos de su primer cliente: O(n × L × K) por pasada
+- 2-opt*: cada cliente u prueba los dos cortes que crean una arista (u, v)
+  con v en su lista: O(n × K) por pasada, casi lineal
 */
 
 
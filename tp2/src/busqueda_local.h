@@ -1,19 +1,118 @@
 #ifndef BUSQUEDA_LOCAL_H
 #define BUSQUEDA_LOCAL_H
 
+#include <chrono>
 #include <vector>
+#include "DistanceMatrix.h"
+#include "NeighborIndex.h"
+#include "estadisticas.h"
 
 using namespace std;
 
+// Primera mejora aplica cada movimiento que mejora apenas lo encuentra;
+// mejor mejora recorre todo el vecindario y aplica solo el mejor.
+enum class ModoBusqueda { PrimeraMejora, MejorMejora };
+
+// Todo lo que un operador necesita saber de la instancia
+struct ContextoBusqueda {
+    const DistanceMatrix& distancias;
+    const vector<int>& demandas;      // por id de nodo
+    int capacidad;
+    const NeighborIndex* vecinos = nullptr;
+    ModoBusqueda modo = ModoBusqueda::PrimeraMejora;
+    // Momento en que hay que cortar. El VND lo mira entre operadores y
+    // devuelve la mejor solución que tenga hasta ese momento
+    chrono::steady_clock::time_point limite = chrono::steady_clock::time_point::max();
+};
+
+// Estado de trabajo de las búsquedas locales: las rutas (cada una empieza y
+// termina en el depósito) con su carga y costo cacheados, y la ruta y posición
+// de cada cliente para ubicarlo en O(1). Los operadores lo modifican en el
+// lugar y solo cuando aceptan un movimiento.
+struct EstadoRutas {
+    vector<vector<int>> rutas;
+    vector<int> carga;       // por ruta
+    // Por ruta y posición: demanda de rutas[r][0..i]. Los operadores la
+    // mantienen al día después de cada movimiento aplicado.
+    vector<vector<int>> carga_acum;
+    vector<double> costo;    // por ruta
+    vector<int> ruta_de;     // por id de cliente (-1 para el depósito)
+    vector<int> pos_de;
+    // Bits "don't look" del 2-opt, por id: 1 si alguna arista del nodo cambió
+    // desde la última vez que se lo miró sin encontrar mejora
+    vector<char> mirar;
+    // Movimientos evaluados por los operadores (solo con kEstadisticas)
+    long long evaluados = 0;
+
+    EstadoRutas(const vector<vector<int>>& rutas, const ContextoBusqueda& ctx);
+
+    // Actualiza ruta_de / pos_de de las posiciones [desde, hasta) de la ruta r
+    void reindexar(int r, size_t desde, size_t hasta);
+    // Recalcula carga_acum[r] desde la posición `desde` y carga[r]
+    void recalcularCargas(int r, size_t desde, const vector<int>& demandas);
+    // Quita las rutas sin clientes y reindexa las que quedan
+    void eliminarRutasVacias();
+    // Vuelve a habilitar al nodo para el 2-opt (sus aristas cambiaron)
+    void marcar(int nodo);
+    void contarEvaluado() {
+        if constexpr (kEstadisticas) ++evaluados;
+    }
+    double costoTotal() const;
+};
+
+// Operadores sobre el estado. Devuelven la variación total del costo (<= 0).
+double mejorarSwap(EstadoRutas& estado, const ContextoBusqueda& ctx);
+// 2-opt intra-ruta en el lugar, solo desde los nodos marcados en `mirar`
+double mejorar2opt(EstadoRutas& estado, const ContextoBusqueda& ctx);
+// Mueven un cliente (Relocate) o una cadena de 2-3 clientes, directa o
+// invertida (Or-opt), a otra ruta. Pueden vaciar rutas: se eliminan.
+double mejorarRelocate(EstadoRutas& estado, const ContextoBusqueda& ctx);
+double mejorarOrOpt(EstadoRutas& estado, const ContextoBusqueda& ctx);
+// Intercambia las colas de dos rutas (2-opt*); puede unir dos rutas en una
+double mejorar2optEstrella(EstadoRutas& estado, const ContextoBusqueda& ctx);
+
+// Si se pasa una lista de vecinos, solo se evalúan movimientos granulares:
+// en Swap, intercambios de u con clientes de su lista; en 2-opt, reversiones
+// que crean una arista (u, v) con v en la lista de u; en Relocate / Or-opt,
+// inserciones de la cadena junto a un vecino de su primer cliente; en 2-opt*,
+// cortes que crean una arista (u, v) con v en la lista de u.
+// Con nullptr se recorre el vecindario completo.
 vector<vector<int>> BusquedaLocalSwap(
     const vector<vector<int>>& rutas,
-    const vector<vector<double>>& distancias,
+    const DistanceMatrix& distancias,
+    const vector<int>& demandas,
+    int capacidad,
+    const NeighborIndex* vecinos = nullptr,
+    ModoBusqueda modo = ModoBusqueda::PrimeraMejora
+);
+vector<vector<int>> BusquedaLocalRelocate(
+    const vector<vector<int>>& rutas,
+    const DistanceMatrix& distancias,
+    const vector<int>& demandas,
+    int capacidad,
+    const NeighborIndex* vecinos = nullptr,
+    ModoBusqueda modo = ModoBusqueda::PrimeraMejora
+);
+vector<vector<int>> BusquedaLocalOrOpt(
+    const vector<vector<int>>& rutas,
+    const DistanceMatrix& distancias,
+    const vector<int>& demandas,
+    int capacidad,
+    const NeighborIndex* vecinos = nullptr,
+    ModoBusqueda modo = ModoBusqueda::PrimeraMejora
+);
+vector<vector<int>> BusquedaLocal2optEstrella(
+    const vector<vector<int>>& rutas,
+    const DistanceMatrix& distancias,
     const vector<int>& demandas,
-    int capacidad
+    int capacidad,
+    const NeighborIndex* vecinos = nullptr,
+    ModoBusqueda modo = ModoBusqueda::PrimeraMejora
 );
 vector<vector<int>> busquedaLocal2opt(
     const vector<vector<int>>& rutas,
-    const vector<vector<double>>& distancias
+    const DistanceMatrix& distancias,
+    const NeighborIndex* vecinos = nullptr
 );
 
 
@@ -1,99 +1,211 @@
 #include "clarkewright.h"
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
-#include <set>
 #include <vector>
-#include <unordered_map>
-#include <tuple>
 #include "armarRutasCortas.h" 
 #include "CVRP_Solution.h"
 #include "VRPLIBReader.h"
+#include "Trace.h"
 using namespace std;  // O cambiar vector por std::vector en cada uso
 
 double distancia(const Cliente& a, const Cliente& b) {
     return sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
 }
 
-vector<vector<int>> clarkewright(const vector<Cliente>& clientes, int capacidad) {
-    const Cliente& deposito = clientes[0];
-    unordered_map<int, vector<int>> rutas;
-    unordered_map<int, int> demandas;
+// Ahorro de unir el cliente i (al final de su ruta) con j (al principio de la suya)
+struct Ahorro {
+    double ahorro;
+    int i;
+    int j;
+};
+
+// Une rutas recorriendo los ahorros en el orden dado (de mayor a menor).
+// Cada ruta es una lista enlazada de clientes (índices densos). La ruta de
+// un cliente se obtiene con union-find, y por ruta (su representante) se
+// guardan los extremos y la carga, así cada unión es O(1) amortizado.
+static vector<vector<int>> unirRutas(const InstanceView& instancia, const vector<Ahorro>& savings) {
+    const vector<int>& ids = instancia.getIds();
+    const vector<int>& demandas = instancia.getDemands();
+    int capacidad = instancia.getCapacity();
+    int n = instancia.size();
+
+    vector<int> padre(n), primero(n), ultimo(n), siguiente(n, -1), carga(n);
+    for (int i = 1; i < n; ++i) {
+        padre[i] = i;
+        primero[i] = ultimo[i] = i;
+        carga[i] = demandas[i];
+    }
+    auto buscar = [&](int c) {
+        while (padre[c] != c) {
+            padre[c] = padre[padre[c]];
+            c = padre[c];
+        }
+        return c;
+    };
+
+    for (const Ahorro& s : savings) {
+        int ri = buscar(s.i);
+        int rj = buscar(s.j);
+        if (ri == rj) continue;
+
+        // Solo se engancha el final de la ruta de i con el principio de la de j
+        if (carga[ri] + carga[rj] <= capacidad && ultimo[ri] == s.i && primero[rj] == s.j) {
+            siguiente[s.i] = s.j;
+            ultimo[ri] = ultimo[rj];
+            carga[ri] += carga[rj];
+            padre[rj] = ri;
+        }
+    }
 
-    for (size_t i = 1; i < clientes.size(); ++i) {
-        rutas[clientes[i].id] = {deposito.id, clientes[i].id, deposito.id};
-        demandas[clientes[i].id] = clientes[i].demanda;
+    int deposito = ids[0];
+    vector<vector<int>> rutas;
+    for (int r = 1; r < n; ++r) {
+        if (padre[r] != r) continue;
+        vector<int> ruta = {deposito};
+        for (int c = primero[r]; c != -1; c = siguiente[c]) ruta.push_back(ids[c]);
+        ruta.push_back(deposito);
+        rutas.push_back(move(ruta));
     }
 
-    vector<tuple<double, int, int>> savings;
-    for (size_t i = 1; i < clientes.size(); ++i) {
-        for (size_t j = i + 1; j < clientes.size(); ++j) {
-        double ahorro = distancia(deposito, clientes[i]) + distancia(deposito, clientes[j]) - distancia(clientes[i], clientes[j]);
-            savings.emplace_back(ahorro, clientes[i].id, clientes[j].id);
+    // Mismo orden que antes (lexicográfico), para que la salida no cambie
+    sort(rutas.begin(), rutas.end());
+    return rutas;
+}
+
+// Ordena de forma estable por clave ascendente: radix LSD con dígitos de
+// 16 bits sobre los primeros `bits` bits de la clave. Se saltea cada pasada
+// en la que todos comparten el dígito.
+template <class Clave>
+static void ordenarRadix(vector<Ahorro>& v, vector<Ahorro>& aux, int bits, Clave clave) {
+    vector<size_t> cuenta(size_t(1) << 16);
+    aux.resize(v.size());
+    for (int desplazamiento = 0; desplazamiento < bits; desplazamiento += 16) {
+        fill(cuenta.begin(), cuenta.end(), 0);
+        for (const Ahorro& a : v) ++cuenta[(clave(a) >> desplazamiento) & 0xFFFF];
+        if (!v.empty() && cuenta[(clave(v[0]) >> desplazamiento) & 0xFFFF] == v.size()) continue;
+
+        size_t suma = 0;
+        for (size_t& c : cuenta) {
+            size_t t = c;
+            c = suma;
+            suma += t;
         }
+        for (const Ahorro& a : v) aux[cuenta[(clave(a) >> desplazamiento) & 0xFFFF]++] = a;
+        v.swap(aux);
     }
+}
+
+// Clave entera que respeta el orden de los double (sin NaN)
+static uint64_t claveOrdenable(double x) {
+    x += 0.0;  // -0.0 pasa a 0.0
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof bits);
+    return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+TerminosAhorro::TerminosAhorro(const InstanceView& instancia)
+    : instancia(instancia),
+      distancias(instancia.hasDistances() ? &instancia.getDistanceMatrix() : nullptr) {
+    int n = instancia.size();
+    al_deposito.assign(n, 0.0);
+    for (int i = 1; i < n; ++i) al_deposito[i] = distancia(0, i);
+
+    const vector<int>& demandas = instancia.getDemands();
+    double media = 0.0;
+    for (int i = 1; i < n; ++i) media += demandas[i];
+    if (n > 1) media /= (n - 1);
+    if (media <= 0.0) media = 1.0;
+    demanda_normalizada.assign(n, 0.0);
+    for (int i = 1; i < n; ++i) demanda_normalizada[i] = demandas[i] / media;
+}
 
-    sort(savings.rbegin(), savings.rend());
+double TerminosAhorro::distancia(int i, int j) const {
+    if (distancias != nullptr) return (*distancias)(instancia.idOf(i), instancia.idOf(j));
+    double dx = instancia.x(i) - instancia.x(j);
+    double dy = instancia.y(i) - instancia.y(j);
+    return sqrt(dx * dx + dy * dy);
+}
 
-    for (const auto& s : savings) {
-        double ahorro;
-        int i, j;
-        tie(ahorro, i, j) = s;
+vector<vector<int>> clarkewright(const TerminosAhorro& terminos, const ParametrosAhorro& parametros) {
+    TRACE_SCOPE("clarkewright");
+    const InstanceView& instancia = terminos.instancia;
+    const vector<int>& ids = instancia.getIds();
+    const vector<double>& d0 = terminos.al_deposito;
+    const vector<double>& q = terminos.demanda_normalizada;
+    int n = instancia.size();
+
+    vector<Ahorro> savings;
+    savings.reserve(static_cast<size_t>(n) * (n - 1) / 2);
+    for (int i = 1; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            double s = d0[i] + d0[j] - parametros.lambda * terminos.distancia(i, j);
+            if (parametros.mu != 0.0) s += parametros.mu * fabs(d0[i] - d0[j]);
+            if (parametros.nu != 0.0) s += parametros.nu * (q[i] + q[j]);
+            savings.push_back({s, i, j});
+        }
+    }
 
-        if (rutas.count(i) && rutas.count(j) && rutas[i] != rutas[j]) {
-            vector<int>& ruta_i = rutas[i];
-            vector<int>& ruta_j = rutas[j];
+    // De mayor a menor ahorro; los empates, por id descendente
+    sort(savings.begin(), savings.end(), [&](const Ahorro& a, const Ahorro& b) {
+        if (a.ahorro != b.ahorro) return a.ahorro > b.ahorro;
+        if (ids[a.i] != ids[b.i]) return ids[a.i] > ids[b.i];
+        return ids[a.j] > ids[b.j];
+    });
 
-            int demanda_total = 0;
-            for (int k = 1; k < ruta_i.size() - 1; ++k)
-                demanda_total += demandas[ruta_i[k]];
-            for (int k = 1; k < ruta_j.size() - 1; ++k)
-                demanda_total += demandas[ruta_j[k]];
+    return unirRutas(instancia, savings);
+}
 
-            if (demanda_total <= capacidad && ruta_i[ruta_i.size() - 2] == i && ruta_j[1] == j) {
-                vector<int> nueva_ruta;
-                nueva_ruta.insert(nueva_ruta.end(), ruta_i.begin(), ruta_i.end() - 1);
-                nueva_ruta.insert(nueva_ruta.end(), ruta_j.begin() + 1, ruta_j.end());
+vector<vector<int>> clarkewright(const InstanceView& instancia) {
+    return clarkewright(TerminosAhorro(instancia), ParametrosAhorro{});
+}
 
-                for (int k = 1; k < nueva_ruta.size() - 1; ++k) {
-                    rutas[nueva_ruta[k]] = nueva_ruta;
-                }
-            }
+vector<vector<int>> clarkewright(const InstanceView& instancia, const NeighborIndex& vecinos) {
+    TRACE_SCOPE("clarkewright");
+    const vector<int>& ids = instancia.getIds();
+    int n = instancia.size();
+    TerminosAhorro terminos(instancia);
+    const vector<double>& al_deposito = terminos.al_deposito;
+
+    // Un ahorro por par (i, j) con j en la lista de i o i en la de j. Los
+    // vecinos mutuos aparecen dos veces; después de ordenar quedan juntos
+    vector<Ahorro> savings;
+    savings.reserve(static_cast<size_t>(n) * vecinos.getK());
+    for (int i = 1; i < n; ++i) {
+        for (int id_j : vecinos.neighbors(ids[i])) {
+            int j = instancia.indexOf(id_j);
+            if (j <= 0) continue;
+            int a = min(i, j), b = max(i, j);
+            savings.push_back({al_deposito[a] + al_deposito[b] - terminos.distancia(a, b), a, b});
         }
     }
 
-    set<vector<int>> unicas;
-    for (const auto& par : rutas) {
-        unicas.insert(par.second);
-    }
+    // Mismo orden que la versión densa (ahorro, id de i, id de j, todo
+    // descendente): tres pasadas estables, de la clave menos significativa a
+    // la más significativa
+    vector<Ahorro> aux;
+    ordenarRadix(savings, aux, 32, [&](const Ahorro& a) { return uint64_t(~uint32_t(ids[a.j])); });
+    ordenarRadix(savings, aux, 32, [&](const Ahorro& a) { return uint64_t(~uint32_t(ids[a.i])); });
+    ordenarRadix(savings, aux, 64, [](const Ahorro& a) { return ~claveOrdenable(a.ahorro); });
+    savings.erase(unique(savings.begin(), savings.end(), [](const Ahorro& a, const Ahorro& b) {
+        return a.i == b.i && a.j == b.j;
+    }), savings.end());
+
+    return unirRutas(instancia, savings);
+}
 
-    return vector<vector<int>>(unicas.begin(), unicas.end());
+vector<vector<int>> clarkewright(const vector<Cliente>& clientes, int capacidad) {
+    return clarkewright(InstanceView(clientes, capacidad));
 }
 
 Solution solveClarkeWright(const VRPLIBReader& instance) {
-    // Paso 1: convertir a vector<Cliente>
-    vector<Node> nodos = instance.getNodes();
-    vector<int> demandas = instance.getDemands();
-    vector<Cliente> clientes;
-
-    for (const auto& nodo : nodos) {
-        Cliente c;
-        c.id = nodo.id;
-        c.x = nodo.x;
-        c.y = nodo.y;
-        c.demanda = demandas[nodo.id];
-        clientes.push_back(c);
-    }
+    InstanceView instancia(instance);
+    vector<vector<int>> rutas = clarkewright(instancia);
 
-    // Paso 2: obtener rutas
-    const auto& distancias = instance.getDistanceMatrix();
-    int capacidad = instance.getCapacity();
-    vector<vector<int>> rutas = clarkewright(clientes, capacidad);
-
-    // Paso 3: cargar la solucion final
     Solution sol;
-    int suma_demanda = 0;
     for (const auto& ruta : rutas) {
-        sol.agregarRuta(ruta, distancias,suma_demanda);
+        sol.agregarRuta(ruta, instancia.getDistanceMatrix(), instancia.routeLoad(ruta));
     }
 
     return sol;
@@ -114,15 +226,25 @@ Sea n la cantidad total de clientes (excluyendo el depósito).
    - Se ordenan los O(n²) elementos → complejidad O(n² log n).
 
 3. Fusión de rutas:
-   - En el peor caso, se intenta unir rutas para cada uno de los O(n²) pares.
-   - Cada intento de fusión puede requerir copiar rutas y verificar demanda total, lo cual es O(n) en el peor caso (aunque en práctica es menor).
+   - Para cada uno de los O(n²) ahorros se busca la ruta de i y de j con
+     union-find (casi O(1)) y se miran los extremos y la carga cacheados.
+   - Unir dos rutas es O(1): se enlaza el último de una con el primero de la
+     otra y se actualizan extremos y carga del representante.
+
+4. Armado de la salida: O(n) para recorrer las listas y O(r log r × m) para
+   ordenarlas como antes.
+
+Complejidad temporal = O(n² log n), dominada por el ordenamiento.
 
-Por lo tanto, la complejidad temporal total es:
+Memoria = O(n²) para los ahorros y O(n) para las rutas (antes, cada cliente
+guardaba una copia de su ruta: O(n²) solo para eso).
 
-   → Cálculo de savings:        O(n²)  
-   → Ordenamiento:              O(n² log n)  
-   → Iteración para fusiones:   O(n² × n) = O(n³) en el peor caso
+Ahorros paramétricos (λ, μ, ν): mismo costo. Las distancias salen de la
+matriz y los términos fijos (distancia al depósito, demanda normalizada) se
+calculan una sola vez en O(n) y se comparten entre parámetros.
 
-Complejidad temporal = O(n³) en el peor caso.
+Versión dispersa (con lista de K vecinos): solo hay O(n × K) ahorros, que se
+ordenan con radix en O(n × K) (ocho pasadas como máximo). Tiempo y memoria
+O(n × K), a cambio de no considerar uniones entre clientes lejanos.
 
 */
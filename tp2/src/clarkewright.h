@@ -1,9 +1,43 @@
 #ifndef CLARKEWRIGHT_H
 #define CLARKEWRIGHT_H
 #include "Cliente.h"
+#include "InstanceView.h"
+#include "NeighborIndex.h"
 #include <vector>
 
-// Declaración de la función Clarke-Wright
+// Forma de los ahorros (Altinkemer–Gavish y Paessens):
+//   s(i,j) = d(0,i) + d(0,j) − λ·d(i,j) + μ·|d(0,i) − d(0,j)| + ν·(q_i + q_j) / q̄
+// donde q̄ es la demanda media. Con λ = 1 y μ = ν = 0 es el Clarke-Wright clásico.
+struct ParametrosAhorro {
+    double lambda = 1.0;
+    double mu = 0.0;
+    double nu = 0.0;
+};
+
+// Términos de los ahorros que no dependen de (λ, μ, ν): distancias al
+// depósito y demandas normalizadas. Se calculan una vez y se comparten (solo
+// lectura) entre todas las corridas de un barrido de parámetros.
+struct TerminosAhorro {
+    // Usa la matriz de la instancia si tiene; si no, las coordenadas
+    explicit TerminosAhorro(const InstanceView& instancia);
+
+    const InstanceView& instancia;
+    const DistanceMatrix* distancias;   // indexada por id; puede ser nullptr
+    std::vector<double> al_deposito;    // por índice denso
+    std::vector<double> demanda_normalizada;
+
+    double distancia(int i, int j) const;   // índices densos
+};
+
+// Clarke-Wright clásico
+std::vector<std::vector<int>> clarkewright(const InstanceView& instancia);
+// Clarke-Wright con los ahorros parametrizados
+std::vector<std::vector<int>> clarkewright(const TerminosAhorro& terminos, const ParametrosAhorro& parametros);
+// Versión dispersa para instancias grandes: solo considera los ahorros de
+// pares (i, j) con j entre los vecinos de i (o al revés). Memoria O(n × K) en
+// vez de O(n²); con todos los pares daría las mismas rutas que la densa.
+std::vector<std::vector<int>> clarkewright(const InstanceView& instancia, const NeighborIndex& vecinos);
+// Igual, sobre una lista de clientes con el depósito en la posición 0
 std::vector<std::vector<int>> clarkewright(const std::vector<Cliente>& clientes, int capacidad);
 
 // Declaración (opcional) de distancia si no está en otro archivo
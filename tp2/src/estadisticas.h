@@ -0,0 +1,18 @@
+#ifndef ESTADISTICAS_H
+#define ESTADISTICAS_H
+
+// Instrumentación de los caminos calientes: movimientos evaluados por
+// operador y tiempo de construcción. Está activa por defecto y se apaga con
+// NDEBUG; se puede forzar con -DCVRP_STATS=0 o -DCVRP_STATS=1. Apagada, los
+// contadores quedan en cero y el compilador elimina los incrementos.
+#ifndef CVRP_STATS
+#ifdef NDEBUG
+#define CVRP_STATS 0
+#else
+#define CVRP_STATS 1
+#endif
+#endif
+
+constexpr bool kEstadisticas = CVRP_STATS != 0;
+
+#endif // ESTADISTICAS_H
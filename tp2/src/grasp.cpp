@@ -4,72 +4,202 @@
 #include "VRPLIBReader.h"
 #include "CVRP_Solution.h"
 #include "armarRutasCortasAleatorizado.h"
+#include "vnd.h"
+#include "InstanceView.h"
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <limits>
+#include <mutex>
 #include <random>
 #include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <thread>
+
+// Semilla de la iteración k derivada de la semilla maestra (splitmix64), así
+// cada iteración tiene su propio flujo sin importar qué hilo la ejecute
+static std::uint64_t semillaIteracion(std::uint64_t semilla, std::uint64_t k) {
+    std::uint64_t z = semilla + (k + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
 
-Solution grasp(const VRPLIBReader& reader, int n_iters, int rcl_size) {
-    // Paso 1: preparar datos
-    std::vector<Node> nodos = reader.getNodes();
-    std::vector<int> demandas = reader.getDemands();
-    std::vector<Cliente> clientes;
-    for (const auto& nodo : nodos) {
-        clientes.push_back({nodo.id, nodo.x, nodo.y, demandas[nodo.id]});
-    }
-
-    // Asegurar que el depósito esté en la primera posición
-    int depot_id = reader.getDepotId();
-    auto it = std::find_if(clientes.begin(), clientes.end(), [&](const Cliente& c) { return c.id == depot_id; });
-    if (it != clientes.end()) {
-        std::iter_swap(clientes.begin(), it);
-    }
+ResultadoGrasp graspConEstadisticas(const VRPLIBReader& reader, const ConfigGrasp& config, VND* vnd) {
+    auto inicio = std::chrono::steady_clock::now();
+    TRACE_SCOPE("grasp");
 
+    // Paso 1: preparar datos (el depósito queda en el índice 0)
+    InstanceView instancia(reader);
     const auto& distancias = reader.getDistanceMatrix();
+    const std::vector<int>& demandas = reader.getDemands();
     int capacidad = reader.getCapacity();
 
-    Solution mejorSol;
-    double mejorCosto = std::numeric_limits<double>::infinity();
-
-    for (int k = 0; k < n_iters; ++k) {
-        // Paso 3: construir una solución greedy aleatorizada
-        std::vector<std::vector<int>> rutas = armarRutasCortasAleatorizado(clientes, capacidad, distancias, rcl_size);
-
-        // Paso 4: aplicar búsqueda local
-        auto rutas_opt = busquedaLocal2opt(rutas, distancias);
-
-        // Calcular costo
-        double costo = 0.0;
-        for (const auto& ruta : rutas_opt) {
-            for (size_t i = 0; i + 1 < ruta.size(); ++i) {
-                int from = ruta[i];
-                int to = ruta[i + 1];
-                auto it_from = std::find_if(clientes.begin(), clientes.end(), [&](const Cliente& c){ return c.id == from; });
-                auto it_to = std::find_if(clientes.begin(), clientes.end(), [&](const Cliente& c){ return c.id == to; });
-                if (it_from != clientes.end() && it_to != clientes.end()) {
-                    int idx_from = std::distance(clientes.begin(), it_from);
-                    int idx_to = std::distance(clientes.begin(), it_to);
-                    costo += distancias[idx_from][idx_to];
-                }
+    ContextoBusqueda ctx{distancias, demandas, capacidad, &reader.getNeighbors()};
+    VND vnd_estandar = VND::estandar();
+    if (vnd == nullptr) vnd = &vnd_estandar;
+
+    // Sin límite de tiempo se hacen exactamente n_iters; con límite, n_iters
+    // es solo un tope (o ninguno, si es <= 0)
+    bool porTiempo = config.limite_ms > 0.0;
+    int maxIteraciones = porTiempo && config.n_iters <= 0 ? std::numeric_limits<int>::max() : config.n_iters;
+    if (porTiempo) {
+        ctx.limite = inicio + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double, std::milli>(config.limite_ms));
+    }
+
+    int hilos = config.hilos > 0 ? config.hilos : static_cast<int>(std::thread::hardware_concurrency());
+    hilos = std::max(1, std::min(hilos, maxIteraciones));
+
+    // Mejor solución compartida. El costo se lee sin lock para descartar
+    // rápido; solo quien mejora toma el mutex y copia sus rutas. A igual costo
+    // gana la iteración más chica, así el resultado no depende del reparto.
+    std::atomic<double> mejorCosto{std::numeric_limits<double>::infinity()};
+    std::mutex mutexMejor;
+    std::vector<std::vector<int>> mejoresRutas;
+    std::vector<int> mejoresCargas;
+    int mejorIteracion = -1;
+    std::vector<PuntoConvergencia> trayectoria;
+
+    std::atomic<int> siguiente{0};
+    std::vector<VND> vnds(hilos, *vnd);
+    for (VND& v : vnds) v.reiniciarEstadisticas();
+
+    // Un constructor por hilo: sus buffers se reusan en todas las iteraciones
+    ConstructorRCL constructor = config.alfa >= 0.0 ? ConstructorRCL::porValor(config.alfa)
+                                                    : ConstructorRCL::porCardinalidad(config.rcl_size);
+    std::vector<ConstructorRCL> constructores(hilos, constructor);
+    // Contadores de construcción por hilo, para no compartir nada en el bucle
+    std::vector<long long> construcciones(hilos, 0);
+    std::vector<double> tiempoConstruccion(hilos, 0.0);
+
+    auto trabajador = [&](int h) {
+        VND& vnd_local = vnds[h];
+        for (int k = siguiente.fetch_add(1); k < maxIteraciones; k = siguiente.fetch_add(1)) {
+            if (k > 0 && porTiempo && std::chrono::steady_clock::now() >= ctx.limite) break;
+            std::uint64_t semilla = semillaIteracion(config.semilla, k);
+            std::seed_seq sembrador{static_cast<std::uint32_t>(semilla), static_cast<std::uint32_t>(semilla >> 32)};
+            std::mt19937 gen(sembrador);
+
+            // Paso 3: construir una solución greedy aleatorizada
+            std::chrono::steady_clock::time_point t1;
+            if constexpr (kEstadisticas) t1 = std::chrono::steady_clock::now();
+            std::vector<std::vector<int>> rutas = constructores[h].construir(instancia, gen);
+            ++construcciones[h];
+            if constexpr (kEstadisticas) {
+                tiempoConstruccion[h] += std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - t1).count();
             }
-        }
 
-        // Paso 5 y 6: guardar si es mejor
-        if (costo < mejorCosto) {
-            mejorCosto = costo;
-            mejorSol = Solution();
-            for (const auto& ruta : rutas_opt) {
-                int suma_demanda = 0;
-                for (int i = 1; i < ruta.size() - 1; ++i) {
-                    int cliente_id = ruta[i];
-                    suma_demanda += clientes[cliente_id].demanda;
+            // Paso 4: aplicar búsqueda local (el VND ya devuelve el costo)
+            EstadoRutas estado(rutas, ctx);
+            double costo = vnd_local.ejecutar(estado, ctx);
+
+            // Paso 5 y 6: guardar si es mejor
+            if (costo > mejorCosto.load(std::memory_order_relaxed)) continue;
+            std::unique_lock<std::mutex> lock(mutexMejor, std::defer_lock);
+            {
+                TRACE_SCOPE("esperaLock");
+                lock.lock();
+            }
+            TRACE_SCOPE("publicarIncumbente");
+            double actual = mejorCosto.load(std::memory_order_relaxed);
+            if (costo < actual || (costo == actual && k < mejorIteracion)) {
+                if (costo < actual) {
+                    double t = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+                    trayectoria.push_back(PuntoConvergencia{t, costo, k});
                 }
-                mejorSol.agregarRuta(ruta, distancias, suma_demanda);
+                mejorCosto.store(costo, std::memory_order_relaxed);
+                mejorIteracion = k;
+                mejoresRutas = std::move(estado.rutas);
+                mejoresCargas = std::move(estado.carga);
             }
         }
+    };
+
+    if (hilos == 1) {
+        trabajador(0);
+    } else {
+        std::vector<std::thread> pool;
+        for (int h = 0; h < hilos; ++h) pool.emplace_back(trabajador, h);
+        for (auto& t : pool) t.join();
     }
 
-    return mejorSol;
+    // Las estadísticas de esta corrida, aparte de las que ya traía el VND
+    VND corrida = vnds[0];
+    corrida.reiniciarEstadisticas();
+    for (const VND& v : vnds) corrida.sumarEstadisticas(v);
+    vnd->sumarEstadisticas(corrida);
+
+    ResultadoGrasp resultado;
+    EstadisticasGrasp& est = resultado.estadisticas;
+    est.hilos = hilos;
+    for (int h = 0; h < hilos; ++h) {
+        est.construcciones += construcciones[h];
+        est.tiempo_construccion_ms += tiempoConstruccion[h];
+    }
+    est.iteraciones = static_cast<int>(est.construcciones);
+    est.trayectoria = std::move(trayectoria);
+    est.busquedas = corrida.getEjecuciones();
+    est.pasadas = corrida.getPasadas();
+    est.operadores = corrida.getEstadisticas();
+
+    Solution& mejorSol = resultado.solucion;
+    mejorSol.reservar(instancia.size() + static_cast<int>(mejoresRutas.size()), static_cast<int>(mejoresRutas.size()));
+    for (size_t r = 0; r < mejoresRutas.size(); ++r) {
+        mejorSol.agregarRuta(mejoresRutas[r], distancias, mejoresCargas[r]);
+    }
+    est.costo = mejorSol.getCostoTotal();
+    est.tiempo_total_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - inicio).count();
+    return resultado;
+}
+
+Solution grasp(const VRPLIBReader& reader, const ConfigGrasp& config, VND* vnd) {
+    return std::move(graspConEstadisticas(reader, config, vnd).solucion);
+}
+
+std::string EstadisticasGrasp::aJSON() const {
+    std::ostringstream s;
+    s << std::setprecision(10);
+    s << "{\"instrumentado\": " << (kEstadisticas ? "true" : "false")
+      << ", \"iteraciones\": " << iteraciones
+      << ", \"hilos\": " << hilos
+      << ", \"costo\": " << costo
+      << ", \"tiempo_total_ms\": " << tiempo_total_ms
+      << ", \"construcciones\": " << construcciones
+      << ", \"tiempo_construccion_ms\": " << tiempo_construccion_ms
+      << ", \"busquedas\": " << busquedas
+      << ", \"pasadas\": " << pasadas
+      << ", \"trayectoria\": [";
+    for (size_t i = 0; i < trayectoria.size(); ++i) {
+        s << (i > 0 ? ", " : "") << "{\"tiempo_ms\": " << trayectoria[i].tiempo_ms
+          << ", \"costo\": " << trayectoria[i].costo << ", \"iteracion\": " << trayectoria[i].iteracion << "}";
+    }
+    s << "]"
+      << ", \"operadores\": [";
+    for (size_t k = 0; k < operadores.size(); ++k) {
+        const EstadisticasOperador& op = operadores[k];
+        s << (k > 0 ? ", " : "")
+          << "{\"nombre\": \"" << op.nombre << "\""
+          << ", \"llamadas\": " << op.llamadas
+          << ", \"mejoras\": " << op.mejoras
+          << ", \"evaluados\": " << op.evaluados
+          << ", \"ganancia\": " << op.ganancia
+          << ", \"tiempo_ms\": " << op.tiempo_ms << "}";
+    }
+    s << "]}";
+    return s.str();
+}
+
+Solution grasp(const VRPLIBReader& reader, int n_iters, int rcl_size, VND* vnd) {
+    ConfigGrasp config;
+    config.n_iters = n_iters;
+    config.rcl_size = rcl_size;
+    return grasp(reader, config, vnd);
 }
 
 /*
@@ -81,21 +211,35 @@ Parámetros:
 - n: cantidad de nodos (clientes + depósito)
 - r: cantidad de rutas generadas por solución
 - m: tamaño promedio de cada ruta (en general, r × m ≈ n)
-- k: cantidad de iteraciones que hace 2-opt hasta estabilizar
+- k: cantidad de iteraciones que hace la búsqueda local hasta estabilizar
 - n_iters: cantidad de iteraciones externas de GRASP
 
 Análisis por iteración:
-- Construcción aleatorizada (armarRutasCortasAleatorizado): O(n³)
-- Búsqueda local con 2-opt sobre r rutas: O(r × k × m³)
-- Cálculo de costo y verificación de mejora: O(n)
-
-Asumiendo r × m ≈ n, el costo por iteración es:
-    → O(n³ + k × n³) = O(k × n³)
+- Construcción aleatorizada (ConstructorRCL): O(n² log rcl_size) recorriendo
+  todos los candidatos; con la grilla (RCL por cardinalidad en instancias
+  planas), típicamente O(n log rcl_size + r × n), ya que solo cerrar cada ruta
+  puede recorrer la grilla entera (ver armarRutasCortasAleatorizado.cpp)
+- Búsqueda local con VND (ver vnd.cpp y busqueda_local.cpp); el costo sale
+  del propio VND, sin recorrer la solución
+- Verificación de mejora: O(1), y copiar la mejor solución: O(n)
+
+Asumiendo r × m ≈ n, el costo por iteración es (con la construcción en su
+peor caso, que igual queda dominada por la búsqueda local):
+    → O(n² log rcl_size + k × n³) = O(k × n³)
 
 Como se realizan n_iters iteraciones del algoritmo GRASP, la complejidad total es:
 
     → O(n_iters × k × n³)
 
+Las iteraciones son independientes y se reparten entre `hilos` hilos, así que
+el tiempo de pared es O(n_iters / hilos × k × n³). Lo único compartido es la
+mejor solución: una lectura atómica por iteración y un lock solo al mejorar.
+
+Con presupuesto de tiempo (limite_ms) el tiempo de pared queda acotado por
+el límite más lo que tarde la operación en curso: una construcción (que no
+se interrumpe) o una llamada a un operador del VND, que mira el reloj entre
+operadores. Mirar el reloj cuesta O(1) por iteración y por operador.
+
 En la práctica:
 - k es acotado (pocas mejoras locales)
 - n_iters se fija manualmente (por ejemplo, 10 o 20)
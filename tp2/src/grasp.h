@@ -3,8 +3,66 @@
 
 #include "VRPLIBReader.h"
 #include "CVRP_Solution.h"
+#include "vnd.h"
+#include <cstdint>
+#include <string>
+#include <vector>
 
-// Ejecuta la metaheurística GRASP con una cantidad de iteraciones y tamaño de RCL
-Solution grasp(const VRPLIBReader& reader, int n_iters, int rcl_size);
+struct ConfigGrasp {
+    int n_iters = 15;            // con limite_ms, <= 0 = sin tope de iteraciones
+    int rcl_size = 3;
+    double alfa = -1.0;          // >= 0: RCL por valor con este α en vez de rcl_size
+    int hilos = 0;               // 0 = todos los núcleos
+    // > 0: presupuesto de tiempo de pared. No se empiezan iteraciones
+    // después del límite y el VND corta entre operadores; se devuelve la
+    // mejor solución hasta ese momento (siempre se completa al menos una
+    // construcción). El resultado ya no es reproducible.
+    double limite_ms = 0.0;
+    // Cada iteración k usa un generador sembrado con (semilla, k), así que el
+    // resultado es el mismo para cualquier cantidad de hilos
+    std::uint64_t semilla = 1;
+};
+
+// Cada vez que mejora la mejor solución: cuándo y a qué costo
+struct PuntoConvergencia {
+    double tiempo_ms;    // desde el inicio de la corrida
+    double costo;
+    int iteracion;
+};
+
+// Dónde se fue el tiempo de una corrida: construcción contra cada operador
+// del VND, y cuántos movimientos se evaluaron contra cuántos mejoraron
+struct EstadisticasGrasp {
+    int iteraciones = 0;                    // las que llegaron a empezar
+    int hilos = 0;
+    long long construcciones = 0;           // llamadas al constructor
+    double tiempo_construccion_ms = 0.0;    // solo con kEstadisticas
+    int busquedas = 0;                      // llamadas al VND
+    long long pasadas = 0;                  // pasadas del VND hasta converger, sumadas
+    std::vector<EstadisticasOperador> operadores;
+    double tiempo_total_ms = 0.0;
+    double costo = 0.0;
+    std::vector<PuntoConvergencia> trayectoria;
+
+    // Objeto JSON con todos los campos y un arreglo por operador
+    std::string aJSON() const;
+};
+
+struct ResultadoGrasp {
+    Solution solucion;
+    EstadisticasGrasp estadisticas;
+};
+
+// GRASP devolviendo también las estadísticas de la corrida (solo las de
+// esta corrida; al VND dado se le suman igual que en grasp)
+ResultadoGrasp graspConEstadisticas(const VRPLIBReader& reader, const ConfigGrasp& config, VND* vnd = nullptr);
+
+// Ejecuta la metaheurística GRASP repartiendo las iteraciones entre hilos.
+// Cada solución construida se mejora con una copia del VND dado
+// (VND::estandar() si es nullptr); sus estadísticas se suman al final.
+Solution grasp(const VRPLIBReader& reader, const ConfigGrasp& config, VND* vnd = nullptr);
+
+// Igual, con la configuración por defecto salvo iteraciones y tamaño de RCL
+Solution grasp(const VRPLIBReader& reader, int n_iters, int rcl_size, VND* vnd = nullptr);
 
 #endif // GRASP_H
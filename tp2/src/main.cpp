@@ -11,14 +11,19 @@
 #include "armarRutasCortasAleatorizado.h"
 #include "busqueda_local.h"
 #include "Cliente.h"
+#include "InstanceView.h"
 #include "grasp.h"
+#include "barrido_ahorros.h"
+#include "recocido.h"
+#include "vnd.h"
+#include "Trace.h"
 
 using namespace std;
 using namespace std::chrono;
 
 void exportarRutas(const string& nombreArchivo,
                    const vector<vector<int>>& rutas,
-                   const vector<Cliente>& clientes) {
+                   const InstanceView& instancia) {
     ofstream archivo(nombreArchivo);
     if (!archivo.is_open()) {
         cerr << "No se pudo abrir el archivo de salida.\n";
@@ -28,10 +33,9 @@ void exportarRutas(const string& nombreArchivo,
     for (size_t i = 0; i < rutas.size(); ++i) {
         archivo << "Ruta " << i + 1 << ":\n";
         for (int id : rutas[i]) {
-            auto it = find_if(clientes.begin(), clientes.end(),
-                              [&](const Cliente& c) { return c.id == id; });
-            if (it != clientes.end()) {
-                archivo << id << " " << it->x << " " << it->y << "\n";
+            int idx = instancia.indexOf(id);
+            if (idx >= 0) {
+                archivo << id << " " << instancia.x(idx) << " " << instancia.y(idx) << "\n";
             }
         }
         archivo << "\n";
@@ -40,124 +44,175 @@ void exportarRutas(const string& nombreArchivo,
     archivo.close();
 }
 
-double calcularCostoTotal(const vector<vector<int>>& rutas,
-                          const vector<vector<double>>& dist_matrix,
-                          const vector<Cliente>& clientes) {
-    double costoTotal = 0.0;
-    for (const auto& ruta : rutas) {
-        for (size_t i = 0; i + 1 < ruta.size(); ++i) {
-            int from = ruta[i], to = ruta[i + 1];
-            auto it_from = find_if(clientes.begin(), clientes.end(), [&](const Cliente& c) { return c.id == from; });
-            auto it_to = find_if(clientes.begin(), clientes.end(), [&](const Cliente& c) { return c.id == to; });
-            if (it_from != clientes.end() && it_to != clientes.end()) {
-                int idx_from = distance(clientes.begin(), it_from);
-                int idx_to = distance(clientes.begin(), it_to);
-                costoTotal += dist_matrix[idx_from][idx_to];
+// Igual, leyendo las rutas directamente del buffer de la solución
+void exportarRutas(const string& nombreArchivo,
+                   const Solution& solucion,
+                   const InstanceView& instancia) {
+    ofstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        cerr << "No se pudo abrir el archivo de salida.\n";
+        return;
+    }
+
+    for (int r = 0; r < solucion.cantidadRutas(); ++r) {
+        archivo << "Ruta " << r + 1 << ":\n";
+        for (int id : solucion.ruta(r)) {
+            int idx = instancia.indexOf(id);
+            if (idx >= 0) {
+                archivo << id << " " << instancia.x(idx) << " " << instancia.y(idx) << "\n";
             }
         }
+        archivo << "\n";
     }
-    return costoTotal;
 }
 
 void imprimirResumen(const string& nombre,
                      const vector<vector<int>>& rutas,
-                     const vector<vector<double>>& dist_matrix,
-                     const vector<Cliente>& clientes,
+                     const InstanceView& instancia,
                      double tiempo_ms) {
-    double costo = calcularCostoTotal(rutas, dist_matrix, clientes);
+    double costo = instancia.totalCost(rutas);
     cout << fixed << setprecision(3);
     cout << nombre << " | Rutas: " << rutas.size()
          << " | Costo: " << costo
          << " | Tiempo: " << tiempo_ms << " ms\n";
 }
 
+void imprimirResumen(const string& nombre,
+                     const Solution& solucion,
+                     double tiempo_ms) {
+    cout << fixed << setprecision(3);
+    cout << nombre << " | Rutas: " << solucion.cantidadRutas()
+         << " | Costo: " << solucion.getCostoTotal()
+         << " | Tiempo: " << tiempo_ms << " ms\n";
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cerr << "Usage: " << argv[0] << " <path_to_vrp_file>\n";
+    // --trace <archivo> guarda una línea de tiempo (Chrome trace) al salir;
+    // --tiempo <ms> corre GRASP y el recocido por tiempo en vez de por
+    // iteraciones / evaluaciones
+    vector<string> args;
+    double limite_ms = 0.0;
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        if (arg == "--trace" && a + 1 < argc) trace::enable(argv[++a]);
+        else if (arg == "--tiempo" && a + 1 < argc) limite_ms = stod(argv[++a]);
+        else args.push_back(arg);
+    }
+    if (args.empty()) {
+        cerr << "Usage: " << argv[0] << " <path_to_vrp_file> [grasp_seed] [--tiempo ms] [--trace file.json]\n";
         return 1;
     }
 
-    VRPLIBReader reader(argv[1]);
+    // Reusa la instancia precompilada (<archivo>.vrpbin) si está al día
+    ReaderOptions opciones;
+    opciones.useBinaryCache = true;
+    VRPLIBReader reader(args[0], opciones);
 
-    vector<Node> nodes = reader.getNodes();
-    vector<Cliente> clientes;
-    for (const Node& n : nodes) {
-        clientes.push_back({n.id, n.x, n.y, n.demanda});
-    }
-
-    int depot_id = reader.getDepotId();
-    auto it = find_if(clientes.begin(), clientes.end(), [&](const Cliente& c) { return c.id == depot_id; });
-    if (it != clientes.end()) iter_swap(clientes.begin(), it);
+    // Índices densos con el depósito en 0
+    InstanceView instancia(reader);
 
-    auto dist_matrix = reader.getDistanceMatrix();
+    const auto& dist_matrix = reader.getDistanceMatrix();
+    // Listas de vecinos cercanos: las búsquedas locales solo prueban movimientos granulares
+    const NeighborIndex* vecinos = &reader.getNeighbors();
 
     // Clarke-Wright base
     auto t1 = high_resolution_clock::now();
-    auto rutas_cw = clarkewright(clientes, reader.getCapacity());
+    auto rutas_cw = clarkewright(instancia);
     auto t2 = high_resolution_clock::now();
-    imprimirResumen("Clarke-Wright", rutas_cw, dist_matrix, clientes,
+    imprimirResumen("Clarke-Wright", rutas_cw, instancia,
                     duration<double, milli>(t2 - t1).count());
 
     // Clarke-Wright + 2-opt
     t1 = high_resolution_clock::now();
-    auto rutas_cw_2opt = busquedaLocal2opt(rutas_cw, dist_matrix);
+    auto rutas_cw_2opt = busquedaLocal2opt(rutas_cw, dist_matrix, vecinos);
     t2 = high_resolution_clock::now();
-    imprimirResumen("Clarke-Wright + 2-opt", rutas_cw_2opt, dist_matrix, clientes,
+    imprimirResumen("Clarke-Wright + 2-opt", rutas_cw_2opt, instancia,
                     duration<double, milli>(t2 - t1).count());
 
+    // Ahorros paramétricos: grilla de (λ, μ, ν) en paralelo, cada una + VND
+    t1 = high_resolution_clock::now();
+    ParametrosAhorro mejores_parametros;
+    Solution sol_barrido = barridoAhorros(reader, ConfigBarrido{}, nullptr, &mejores_parametros);
+    t2 = high_resolution_clock::now();
+    imprimirResumen("Barrido de ahorros + VND", sol_barrido,
+                    duration<double, milli>(t2 - t1).count());
+    cout << "  λ = " << mejores_parametros.lambda << ", μ = " << mejores_parametros.mu
+         << ", ν = " << mejores_parametros.nu << "\n";
+
     // Rutas Cortas base
     t1 = high_resolution_clock::now();
-    auto rutas_cortas = armarRutasCortas(clientes, reader.getCapacity(), dist_matrix);
+    auto rutas_cortas = armarRutasCortas(instancia);
     t2 = high_resolution_clock::now();
-    imprimirResumen("Rutas Cortas", rutas_cortas, dist_matrix, clientes,
+    imprimirResumen("Rutas Cortas", rutas_cortas, instancia,
                     duration<double, milli>(t2 - t1).count());
 
     // Rutas Cortas + Swap
     t1 = high_resolution_clock::now();
     auto rutas_base_para_swap = rutas_cortas; // ← copia real
-    auto rutas_cortas_swap = BusquedaLocalSwap(rutas_base_para_swap, dist_matrix, reader.getDemands(), reader.getCapacity());
+    auto rutas_cortas_swap = BusquedaLocalSwap(rutas_base_para_swap, dist_matrix, reader.getDemands(), reader.getCapacity(), vecinos);
     t2 = high_resolution_clock::now();
-    imprimirResumen("Rutas Cortas + Swap", rutas_cortas_swap, dist_matrix, clientes,
+    imprimirResumen("Rutas Cortas + Swap", rutas_cortas_swap, instancia,
                     duration<double, milli>(t2 - t1).count());
 
-    // Rutas Cortas + VND (Swap + 2-opt)
+    // Rutas Cortas + VND
     t1 = high_resolution_clock::now();
-    auto rutas_vnd = rutas_cortas;
-    bool mejoro = true;
-    while (mejoro) {
-        mejoro = false;
-        auto swap = BusquedaLocalSwap(rutas_vnd, dist_matrix, reader.getDemands(), reader.getCapacity());
-        if (calcularCostoTotal(swap, dist_matrix, clientes) < calcularCostoTotal(rutas_vnd, dist_matrix, clientes)) {
-            rutas_vnd = swap;
-            mejoro = true;
-        }
-        auto opt = busquedaLocal2opt(rutas_vnd, dist_matrix);
-        if (calcularCostoTotal(opt, dist_matrix, clientes) < calcularCostoTotal(rutas_vnd, dist_matrix, clientes)) {
-            rutas_vnd = opt;
-            mejoro = true;
-        }
-    }
+    ContextoBusqueda ctx{dist_matrix, reader.getDemands(), reader.getCapacity(), vecinos};
+    VND vnd = VND::estandar();
+    EstadoRutas estado_vnd(rutas_cortas, ctx);
+    vnd.ejecutar(estado_vnd, ctx);
+    auto rutas_vnd = estado_vnd.rutas;
     t2 = high_resolution_clock::now();
-    imprimirResumen("Rutas Cortas + VND (Swap + 2-opt)", rutas_vnd, dist_matrix, clientes,
+    imprimirResumen("Rutas Cortas + VND", rutas_vnd, instancia,
                     duration<double, milli>(t2 - t1).count());
+    vnd.imprimirEstadisticas();
 
     // GRASP
     t1 = high_resolution_clock::now();
-    int n_iters = 15;
-    int rcl_size = 3;
-    Solution sol_grasp = grasp(reader, n_iters, rcl_size);
-    auto rutas_grasp = sol_grasp.getRutas();
+    ConfigGrasp config;
+    config.n_iters = 15;
+    config.rcl_size = 3;
+    if (limite_ms > 0.0) {
+        config.n_iters = 0;
+        config.limite_ms = limite_ms;
+    }
+    if (args.size() > 1) config.semilla = stoull(args[1]);
+    VND vnd_grasp = VND::estandar();
+    ResultadoGrasp resultado_grasp = graspConEstadisticas(reader, config, &vnd_grasp);
+    const Solution& sol_grasp = resultado_grasp.solucion;
+    t2 = high_resolution_clock::now();
+    imprimirResumen("GRASP", sol_grasp,
+                    duration<double, milli>(t2 - t1).count());
+    vnd_grasp.imprimirEstadisticas();
+    cout << "  Construcciones: " << resultado_grasp.estadisticas.construcciones
+         << " | Mejoras de la mejor solución: " << resultado_grasp.estadisticas.trayectoria.size() << "\n";
+    ofstream("estadisticas_grasp.json") << resultado_grasp.estadisticas.aJSON() << "\n";
+
+    // Recocido simulado (desde Clarke-Wright con listas de vecinos)
+    t1 = high_resolution_clock::now();
+    ConfigRecocido config_recocido;
+    config_recocido.semilla = config.semilla;
+    config_recocido.limite_ms = limite_ms;
+    if (limite_ms <= 0.0) config_recocido.max_evaluaciones = 5000000;
+    ResultadoRecocido resultado_recocido = recocidoSimulado(reader, config_recocido);
+    const Solution& sol_recocido = resultado_recocido.solucion;
     t2 = high_resolution_clock::now();
-    imprimirResumen("GRASP", rutas_grasp, dist_matrix, clientes,
+    imprimirResumen("Recocido simulado", sol_recocido,
                     duration<double, milli>(t2 - t1).count());
+    const EstadisticasRecocido& est_recocido = resultado_recocido.estadisticas;
+    cout << "  Evaluaciones: " << est_recocido.evaluaciones
+         << " | Aceptados: " << est_recocido.aceptados
+         << " | T0: " << est_recocido.temperatura_inicial << "\n";
+    ofstream("estadisticas_recocido.json") << est_recocido.aJSON() << "\n";
 
                     
-    exportarRutas("rutas_cw.txt", rutas_cw, clientes);
-    exportarRutas("rutas_cw_2opt.txt", rutas_cw_2opt, clientes);
-    exportarRutas("rutas_cortas.txt", rutas_cortas, clientes);
-    exportarRutas("rutas_cortas_swap.txt", rutas_cortas_swap, clientes);
-    exportarRutas("rutas_vnd.txt", rutas_vnd, clientes);
-    exportarRutas("rutas_grasp.txt", rutas_grasp, clientes);
+    exportarRutas("rutas_cw.txt", rutas_cw, instancia);
+    exportarRutas("rutas_cw_2opt.txt", rutas_cw_2opt, instancia);
+    exportarRutas("rutas_barrido.txt", sol_barrido, instancia);
+    exportarRutas("rutas_cortas.txt", rutas_cortas, instancia);
+    exportarRutas("rutas_cortas_swap.txt", rutas_cortas_swap, instancia);
+    exportarRutas("rutas_vnd.txt", rutas_vnd, instancia);
+    exportarRutas("rutas_grasp.txt", sol_grasp, instancia);
+    exportarRutas("rutas_recocido.txt", sol_recocido, instancia);
 
     return 0;
 }
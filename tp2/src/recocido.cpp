@@ -0,0 +1,227 @@
+#include "recocido.h"
+#include "InstanceView.h"
+#include "clarkewright.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+// Evaluaciones entre dos actualizaciones de la temperatura (y lecturas del reloj)
+static const long long kEscalon = 4096;
+
+// splitmix64 (el mismo mezclador de semillaIteracion en grasp.cpp) usado como
+// generador: un número por evaluación, y mt19937_64 se llevaba un tercio del tiempo
+struct GeneradorRapido {
+    std::uint64_t estado;
+    std::uint64_t operator()() {
+        std::uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+ResultadoRecocido recocidoSimulado(Solution inicial, const ContextoBusqueda& ctx, const ConfigRecocido& config) {
+    auto inicio = std::chrono::steady_clock::now();
+    TRACE_SCOPE("recocidoSimulado");
+    if (ctx.vecinos == nullptr || ctx.vecinos->getK() == 0) {
+        throw std::runtime_error("Error: el recocido simulado necesita listas de vecinos");
+    }
+    if (config.limite_ms <= 0.0 && config.max_evaluaciones <= 0) {
+        throw std::runtime_error("Error: el recocido simulado necesita un límite de tiempo o de evaluaciones");
+    }
+
+    Solution sol = std::move(inicial);
+    if (!sol.enlazada()) sol.enlazar(ctx.distancias, ctx.demandas, ctx.capacidad);
+    const NeighborIndex& vecinos = *ctx.vecinos;
+    const std::uint64_t k = vecinos.getK();
+
+    std::vector<int> clientes;
+    for (int r = 0; r < sol.cantidadRutas(); ++r) {
+        VistaRuta ruta = sol.ruta(r);
+        clientes.insert(clientes.end(), ruta.begin() + 1, ruta.end() - 1);
+    }
+    const std::uint64_t nc = clientes.size();
+
+    ResultadoRecocido resultado;
+    EstadisticasRecocido& est = resultado.estadisticas;
+    est.costo_inicial = sol.getCostoTotal();
+
+    GeneradorRapido gen{config.semilla};
+    auto uniforme = [&]() { return (gen() >> 11) * 0x1.0p-53; };
+
+    // Arma con 64 bits al azar un movimiento que deja al cliente u junto a su
+    // vecino v y se lo pasa a `visitar`. Descarta los que no cambian nada.
+    const std::uint64_t hastaRelocate = static_cast<std::uint64_t>(config.prob_relocate * 32768.0);
+    const std::uint64_t hastaSwap = hastaRelocate + static_cast<std::uint64_t>(config.prob_swap * 32768.0);
+    auto muestrear = [&](std::uint64_t bits, auto&& visitar) {
+        int u = clientes[((bits & 0xFFFFFFFF) * nc) >> 32];
+        int v = vecinos.neighbors(u)[(((bits >> 32) & 0xFFFF) * k) >> 16];
+        if (!sol.contiene(v)) return;
+        std::uint64_t tipo = (bits >> 48) & 0x7FFF;
+        bool variante = bits >> 63;
+        int ru = sol.rutaDeCliente(u), rv = sol.rutaDeCliente(v);
+        int pu = sol.posicionDeCliente(u), pv = sol.posicionDeCliente(v);
+
+        if (tipo < hastaRelocate) {
+            // u justo antes o justo después de v (posición contada sin u)
+            int posicion = variante ? pv + 1 : pv;
+            if (ru == rv && pu < posicion) --posicion;
+            if (ru == rv && posicion == pu) return;
+            visitar(MovRelocate{u, rv, posicion});
+        } else if (tipo < hastaSwap) {
+            visitar(MovSwap{u, v});
+        } else if (ru == rv) {
+            // Reversión que crea la arista (u, v) como (a, c) o como (b, e)
+            int lo = std::min(pu, pv), hi = std::max(pu, pv);
+            visitar(variante ? Mov2opt{ru, lo + 1, hi} : Mov2opt{ru, lo, hi - 1});
+        } else {
+            visitar(variante ? Mov2optEstrella{ru, pu, rv, pv - 1} : Mov2optEstrella{ru, pu - 1, rv, pv});
+        }
+    };
+
+    // Calibración: empeoramiento promedio de movimientos factibles al azar
+    double temperatura = config.temperatura_inicial;
+    if (temperatura < 0.0) {
+        double suma = 0.0;
+        int empeoran = 0;
+        for (int intento = 0; intento < 10000 && empeoran < 1000; ++intento) {
+            muestrear(gen(), [&](auto mov) {
+                if (!sol.factible(mov)) return;
+                double delta = sol.delta(mov);
+                if (delta > 0.0) {
+                    suma += delta;
+                    ++empeoran;
+                }
+            });
+        }
+        double aceptacion = std::min(std::max(config.aceptacion_inicial, 1e-6), 1.0 - 1e-6);
+        temperatura = empeoran > 0 ? -(suma / empeoran) / std::log(aceptacion) : 0.0;
+    }
+    const double t0 = temperatura;
+    const double razon = config.temperatura_final_relativa;
+    est.temperatura_inicial = t0;
+
+    // La mejor solución se copia recién cuando se la abandona con un
+    // movimiento que empeora; mientras tanto es la actual
+    Solution mejor;
+    double mejorCosto = sol.getCostoTotal();
+    bool enMejor = true;
+    double umbral = 0.0;  // empeoramientos desde acá no se aceptan nunca
+
+    auto intentar = [&](auto mov) {
+        if (!sol.factible(mov)) return;
+        ++est.factibles;
+        double delta = sol.delta(mov);
+        if (delta > 0.0) {
+            if (delta >= umbral || uniforme() >= std::exp(-delta / temperatura)) return;
+            if (enMejor) {
+                mejor = sol.clone();
+                enMejor = false;
+            }
+        }
+        sol.aplicar(mov);
+        ++est.aceptados;
+        double costo = sol.getCostoTotal();
+        if (costo < mejorCosto - 1e-9) {
+            mejorCosto = costo;
+            enMejor = true;
+            ++est.mejoras;
+        }
+    };
+
+    double ultimoRegistrado = std::numeric_limits<double>::infinity();
+    for (int escalon = 0;; ++escalon) {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        if (mejorCosto < ultimoRegistrado) {
+            est.trayectoria.push_back(PuntoConvergencia{ms, mejorCosto, escalon});
+            ultimoRegistrado = mejorCosto;
+        }
+
+        double progreso = 0.0;
+        if (config.max_evaluaciones > 0) progreso = static_cast<double>(est.evaluaciones) / config.max_evaluaciones;
+        if (config.limite_ms > 0.0) progreso = std::max(progreso, ms / config.limite_ms);
+        if (progreso >= 1.0) break;
+        temperatura = t0 > 0.0 ? t0 * std::pow(razon, progreso) : 0.0;
+        // exp(-30) ≈ 1e-13: no vale la pena sortear
+        umbral = 30.0 * temperatura;
+
+        long long pasos = kEscalon;
+        if (config.max_evaluaciones > 0) pasos = std::min(pasos, config.max_evaluaciones - est.evaluaciones);
+        for (long long s = 0; s < pasos; ++s) muestrear(gen(), intentar);
+        est.evaluaciones += pasos;
+    }
+    est.temperatura_final = temperatura;
+
+    // Salida sin las rutas que quedaron vacías, con los costos recalculados
+    const Solution& elegida = enMejor ? sol : mejor;
+    Solution& salida = resultado.solucion;
+    salida.reservar(static_cast<int>(nc) + 2 * elegida.cantidadRutas(), elegida.cantidadRutas());
+    for (int r = 0; r < elegida.cantidadRutas(); ++r) {
+        if (elegida.tamanioRuta(r) == 0) continue;
+        salida.agregarRuta(elegida.ruta(r).aVector(), ctx.distancias, elegida.cargaRuta(r));
+    }
+    est.costo = salida.getCostoTotal();
+    est.tiempo_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+    return resultado;
+}
+
+ResultadoRecocido recocidoSimulado(const VRPLIBReader& reader, const ConfigRecocido& config) {
+    InstanceView instancia(reader);
+    const NeighborIndex& vecinos = reader.getNeighbors();
+    ContextoBusqueda ctx{reader.getDistanceMatrix(), reader.getDemands(), reader.getCapacity(), &vecinos};
+
+    std::vector<std::vector<int>> rutas = clarkewright(instancia, vecinos);
+    Solution inicial;
+    inicial.reservar(instancia.size() + static_cast<int>(rutas.size()), static_cast<int>(rutas.size()));
+    for (const auto& ruta : rutas) {
+        inicial.agregarRuta(ruta, ctx.distancias, instancia.routeLoad(ruta));
+    }
+    return recocidoSimulado(std::move(inicial), ctx, config);
+}
+
+std::string EstadisticasRecocido::aJSON() const {
+    std::ostringstream s;
+    s << std::setprecision(10);
+    s << "{\"evaluaciones\": " << evaluaciones
+      << ", \"factibles\": " << factibles
+      << ", \"aceptados\": " << aceptados
+      << ", \"mejoras\": " << mejoras
+      << ", \"temperatura_inicial\": " << temperatura_inicial
+      << ", \"temperatura_final\": " << temperatura_final
+      << ", \"costo_inicial\": " << costo_inicial
+      << ", \"costo\": " << costo
+      << ", \"tiempo_ms\": " << tiempo_ms
+      << ", \"trayectoria\": [";
+    for (size_t i = 0; i < trayectoria.size(); ++i) {
+        s << (i > 0 ? ", " : "") << "{\"tiempo_ms\": " << trayectoria[i].tiempo_ms
+          << ", \"costo\": " << trayectoria[i].costo << ", \"escalon\": " << trayectoria[i].iteracion << "}";
+    }
+    s << "]}";
+    return s.str();
+}
+
+/*
+-----------------------------------------------------------
+Complejidad del recocido simulado
+-----------------------------------------------------------
+
+Sea n la cantidad de clientes y K el largo de las listas de vecinos.
+
+- Muestrear un movimiento: O(1) (un número al azar de 64 bits da el cliente,
+  el vecino y el tipo).
+- Factibilidad y variación de costo: O(1), con la carga acumulada y los
+  vecinos en la ruta que mantiene Solution.
+- Aplicar un movimiento aceptado: O(largo de ruta) para 2-opt, y O(n) para
+  relocate / 2-opt* entre rutas (corren el buffer plano). Solo se paga por
+  los aceptados, que al bajar la temperatura son pocos.
+- Guardar la mejor: O(n), solo al abandonarla con un movimiento que empeora.
+- Reloj y temperatura: una vez cada 4096 evaluaciones.
+
+Sin NDEBUG, aplicar() verifica la solución entera (O(n)) en cada movimiento:
+para medir velocidad hay que compilar con -DNDEBUG.
+*/
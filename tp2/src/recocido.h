@@ -0,0 +1,66 @@
+#ifndef RECOCIDO_H
+#define RECOCIDO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "VRPLIBReader.h"
+#include "CVRP_Solution.h"
+#include "busqueda_local.h"
+#include "grasp.h"
+
+struct ConfigRecocido {
+    // Corta con lo que llegue primero; al menos uno de los dos tiene que ser
+    // > 0. Solo con max_evaluaciones (limite_ms = 0) el resultado es
+    // reproducible: el enfriamiento avanza por evaluaciones y no por reloj.
+    double limite_ms = 1000.0;
+    long long max_evaluaciones = 0;
+    std::uint64_t semilla = 1;
+    // Temperatura inicial: con < 0 se calibra para que un empeoramiento
+    // promedio (muestreado sobre la solución inicial) se acepte con
+    // probabilidad `aceptacion_inicial`
+    double temperatura_inicial = -1.0;
+    double aceptacion_inicial = 0.5;
+    // Enfriamiento geométrico: T = T0 × (T_final / T0)^progreso, con el
+    // progreso en [0, 1] según el tiempo o las evaluaciones consumidas
+    double temperatura_final_relativa = 1e-3;
+    // Probabilidad de cada tipo de movimiento; el resto es 2-opt (2-opt*
+    // si los dos clientes están en rutas distintas)
+    double prob_relocate = 0.4;
+    double prob_swap = 0.3;
+};
+
+struct EstadisticasRecocido {
+    long long evaluaciones = 0;     // movimientos muestreados
+    long long factibles = 0;
+    long long aceptados = 0;
+    long long mejoras = 0;          // veces que bajó la mejor solución
+    double temperatura_inicial = 0.0;
+    double temperatura_final = 0.0;
+    double costo_inicial = 0.0;
+    double costo = 0.0;
+    double tiempo_ms = 0.0;
+    // Mejor costo al final de cada escalón de temperatura en el que bajó
+    // (`iteracion` es el número de escalón)
+    std::vector<PuntoConvergencia> trayectoria;
+
+    std::string aJSON() const;
+};
+
+struct ResultadoRecocido {
+    Solution solucion;
+    EstadisticasRecocido estadisticas;
+};
+
+// Recocido simulado sobre la solución dada. Cada paso toma un cliente u al
+// azar y un vecino v de su lista (ctx.vecinos, obligatoria) y prueba un
+// movimiento que deja a u junto a v: relocate, swap o 2-opt. Factibilidad y
+// variación de costo son O(1) (ver los movimientos de Solution); solo los
+// aceptados modifican la solución. Devuelve la mejor encontrada, sin rutas
+// vacías.
+ResultadoRecocido recocidoSimulado(Solution inicial, const ContextoBusqueda& ctx, const ConfigRecocido& config);
+
+// Igual, partiendo de Clarke-Wright sobre las listas de vecinos
+ResultadoRecocido recocidoSimulado(const VRPLIBReader& reader, const ConfigRecocido& config);
+
+#endif // RECOCIDO_H
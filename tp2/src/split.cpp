@@ -0,0 +1,209 @@
+#include "split.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Tolerancia de las comparaciones de dominancia (costos en double)
+static const double EPS = 1e-9;
+
+Split::Split(const InstanceView& instancia) : instancia(instancia) {
+    int n = instancia.size();
+    cliente.reserve(n);
+    ida.reserve(n + 1);
+    vuelta.reserve(n + 1);
+    distanciaAcum.reserve(n + 1);
+    cargaAcum.reserve(n + 1);
+    potencial.reserve(n);
+    anterior.reserve(n);
+    cola.reserve(n);
+}
+
+bool Split::preparar(const std::vector<int>& tour) {
+    const DistanceMatrix& d = instancia.getDistanceMatrix();
+    int deposito = instancia.getDepotId();
+    int capacidad = instancia.getCapacity();
+    int n = static_cast<int>(tour.size());
+
+    // La posición 0 queda sin usar para que p = 1..n coincida con el tour
+    cliente.assign(n + 1, deposito);
+    ida.assign(n + 2, 0.0);
+    vuelta.assign(n + 1, 0.0);
+    distanciaAcum.assign(n + 2, 0.0);
+    cargaAcum.assign(n + 1, 0);
+    for (int p = 1; p <= n; ++p) {
+        int c = tour[p - 1];
+        int q = instancia.demandOfId(c);
+        if (q > capacidad) return false;
+        cliente[p] = c;
+        ida[p] = d(deposito, c);
+        vuelta[p] = d(c, deposito);
+        distanciaAcum[p] = p > 1 ? distanciaAcum[p - 1] + d(cliente[p - 1], c) : 0.0;
+        cargaAcum[p] = cargaAcum[p - 1] + q;
+    }
+    return true;
+}
+
+void Split::armarRutas(int n, int fila, std::vector<std::vector<int>>& rutas) const {
+    int deposito = instancia.getDepotId();
+    rutas.clear();
+    for (int j = n; j > 0; --fila) {
+        int i = anterior[static_cast<size_t>(std::max(fila, 0)) * (n + 1) + j];
+        std::vector<int> ruta;
+        ruta.reserve(j - i + 2);
+        ruta.push_back(deposito);
+        for (int p = i + 1; p <= j; ++p) ruta.push_back(cliente[p]);
+        ruta.push_back(deposito);
+        rutas.push_back(std::move(ruta));
+        j = i;
+    }
+    std::reverse(rutas.begin(), rutas.end());
+}
+
+double Split::dividir(const std::vector<int>& tour, std::vector<std::vector<int>>& rutas) {
+    rutas.clear();
+    if (!preparar(tour)) return INFACTIBLE;
+    int n = static_cast<int>(tour.size());
+    if (n == 0) return 0.0;
+    int capacidad = instancia.getCapacity();
+    potencial.assign(n + 1, INFACTIBLE);
+    anterior.assign(n + 1, 0);
+    cola.assign(n + 1, 0);
+    potencial[0] = 0.0;
+
+    // Costo de cortar después de i y rutear i+1..j
+    auto propagar = [&](int i, int j) {
+        return potencial[i] + ida[i + 1] + distanciaAcum[j] - distanciaAcum[i + 1] + vuelta[j];
+    };
+    // i (antes en la cola) domina a j: misma carga y mejor para todo destino
+    auto domina = [&](int i, int j) {
+        return cargaAcum[i] == cargaAcum[j] &&
+               potencial[j] + ida[j + 1] > potencial[i] + ida[i + 1] + distanciaAcum[j + 1] - distanciaAcum[i + 1] - EPS;
+    };
+    // j domina a i por la derecha: mejor hoy, y i sale antes de la cola por carga
+    auto dominaDerecha = [&](int i, int j) {
+        return potencial[j] + ida[j + 1] < potencial[i] + ida[i + 1] + distanciaAcum[j + 1] - distanciaAcum[i + 1] + EPS;
+    };
+
+    // Cola de cortes candidatos: el mejor está adelante, y se descartan por
+    // atrás los dominados y por adelante los que dejan una ruta sobrecargada
+    int frente = 0, fondo = 0;
+    cola[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        potencial[j] = propagar(cola[frente], j);
+        anterior[j] = cola[frente];
+        if (j < n) {
+            if (!domina(cola[fondo], j)) {
+                while (fondo >= frente && dominaDerecha(cola[fondo], j)) --fondo;
+                cola[++fondo] = j;
+            }
+            while (cargaAcum[j + 1] - cargaAcum[cola[frente]] > capacidad) ++frente;
+        }
+    }
+
+    armarRutas(n, -1, rutas);
+    return potencial[n];
+}
+
+double Split::dividir(const std::vector<int>& tour, int vehiculos, std::vector<std::vector<int>>& rutas) {
+    double costo = dividir(tour, rutas);
+    if (costo == INFACTIBLE || static_cast<int>(rutas.size()) <= vehiculos) return costo;
+
+    rutas.clear();
+    int n = static_cast<int>(tour.size());
+    int K = std::min(vehiculos, n);
+    if (K <= 0) return INFACTIBLE;
+    int capacidad = instancia.getCapacity();
+    size_t ancho = static_cast<size_t>(n) + 1;
+    // Fila k: costo mínimo usando exactamente k rutas
+    potencial.assign((K + 1) * ancho, INFACTIBLE);
+    anterior.assign((K + 1) * ancho, 0);
+    potencial[0] = 0.0;
+
+    for (int k = 0; k < K; ++k) {
+        const double* pot = potencial.data() + k * ancho;
+        double* siguiente = potencial.data() + (k + 1) * ancho;
+        int* previo = anterior.data() + (k + 1) * ancho;
+        auto propagar = [&](int i, int j) {
+            return pot[i] + ida[i + 1] + distanciaAcum[j] - distanciaAcum[i + 1] + vuelta[j];
+        };
+        auto domina = [&](int i, int j) {
+            return cargaAcum[i] == cargaAcum[j] &&
+                   pot[j] + ida[j + 1] > pot[i] + ida[i + 1] + distanciaAcum[j + 1] - distanciaAcum[i + 1] - EPS;
+        };
+        auto dominaDerecha = [&](int i, int j) {
+            return pot[j] + ida[j + 1] < pot[i] + ida[i + 1] + distanciaAcum[j + 1] - distanciaAcum[i + 1] + EPS;
+        };
+
+        // Con k rutas las primeras posiciones alcanzables son un prefijo: los
+        // cortes infactibles no entran a la cola
+        if (pot[k] == INFACTIBLE) break;
+        int frente = 0, fondo = 0;
+        cola[0] = k;
+        for (int j = k + 1; j <= n && frente <= fondo; ++j) {
+            siguiente[j] = propagar(cola[frente], j);
+            previo[j] = cola[frente];
+            if (j < n) {
+                if (pot[j] != INFACTIBLE && !domina(cola[fondo], j)) {
+                    while (fondo >= frente && dominaDerecha(cola[fondo], j)) --fondo;
+                    cola[++fondo] = j;
+                }
+                while (frente <= fondo && cargaAcum[j + 1] - cargaAcum[cola[frente]] > capacidad) ++frente;
+            }
+        }
+    }
+
+    int mejorK = -1;
+    for (int k = 1; k <= K; ++k) {
+        double c = potencial[k * ancho + n];
+        if (c < INFACTIBLE && (mejorK < 0 || c < potencial[mejorK * ancho + n])) mejorK = k;
+    }
+    if (mejorK < 0) return INFACTIBLE;
+    armarRutas(n, mejorK, rutas);
+    return potencial[mejorK * ancho + n];
+}
+
+std::vector<int> tourGigante(const std::vector<std::vector<int>>& rutas) {
+    std::vector<int> tour;
+    for (const auto& ruta : rutas) {
+        for (size_t i = 1; i + 1 < ruta.size(); ++i) tour.push_back(ruta[i]);
+    }
+    return tour;
+}
+
+Solution solucionDesdeTour(const VRPLIBReader& reader, const std::vector<int>& tour) {
+    InstanceView instancia(reader);
+    Split split(instancia);
+    std::vector<std::vector<int>> rutas;
+    if (split.dividir(tour, reader.getNumVehicles(), rutas) == Split::INFACTIBLE) {
+        throw std::runtime_error("Error: el tour no se puede cortar en " +
+                                 std::to_string(reader.getNumVehicles()) + " rutas factibles");
+    }
+
+    Solution sol;
+    for (const auto& ruta : rutas) {
+        sol.agregarRuta(ruta, reader.getDistanceMatrix(), instancia.routeLoad(ruta));
+    }
+    return sol;
+}
+
+/*
+-----------------------------------------------------------
+Complejidad de Split
+-----------------------------------------------------------
+
+Sea n la cantidad de clientes del tour y K la cantidad de vehículos.
+
+- Acumulados (distancia a lo largo del tour, carga, idas y vueltas): O(n).
+- Flota ilimitada: potencial[j] = min sobre cortes i de potencial[i] + costo
+  de la ruta i+1..j. Cada i entra y sale de la cola una sola vez, y el
+  frente de la cola es siempre el mejor corte factible (los dominados se
+  sacan por atrás, los que sobrecargan la ruta por adelante) → O(n).
+- Flota acotada: la misma recurrencia por cantidad de rutas k = 1..K, cada
+  fila en O(n) → O(n × K). Solo se corre si el split sin límite usa más de K
+  rutas.
+- Armar las rutas: O(n).
+
+Memoria: O(n) sin límite, O(n × K) con límite.
+
+-----------------------------------------------------------
+*/
@@ -0,0 +1,52 @@
+#ifndef SPLIT_H
+#define SPLIT_H
+
+#include <limits>
+#include <vector>
+#include "CVRP_Solution.h"
+#include "InstanceView.h"
+#include "VRPLIBReader.h"
+
+// Tour gigante: todos los clientes (ids) en un orden, sin el depósito. Split
+// lo corta en rutas consecutivas que respetan la capacidad, eligiendo los
+// cortes de costo mínimo (Prins 2004; versión lineal de Vidal 2016).
+// Los buffers se reservan una vez y se reusan en cada llamada, así que
+// conviene un Split por hilo para decodificar muchos tours.
+class Split {
+public:
+    static constexpr double INFACTIBLE = std::numeric_limits<double>::infinity();
+
+    // La instancia tiene que tener matriz de distancias y durar más que el Split
+    explicit Split(const InstanceView& instancia);
+
+    // Flota ilimitada, O(n). Devuelve el costo de las rutas (INFACTIBLE si
+    // algún cliente no entra solo en un vehículo).
+    double dividir(const std::vector<int>& tour, std::vector<std::vector<int>>& rutas);
+
+    // Como mucho `vehiculos` rutas. Si el split sin límite ya usa pocas, es
+    // ese; si no, O(n × vehiculos). INFACTIBLE si no hay forma de cortar.
+    double dividir(const std::vector<int>& tour, int vehiculos, std::vector<std::vector<int>>& rutas);
+
+private:
+    const InstanceView& instancia;
+    // Posición p = 1..n del tour: cliente, distancias al depósito, acumulados
+    std::vector<int> cliente;
+    std::vector<double> ida, vuelta, distanciaAcum;
+    std::vector<int> cargaAcum;
+    std::vector<double> potencial;     // costo mínimo de rutear las primeras p posiciones
+    std::vector<int> anterior;         // último corte antes de la posición p
+    std::vector<int> cola;             // deque como vector + índices
+
+    // Prepara los acumulados; false si algún cliente supera la capacidad
+    bool preparar(const std::vector<int>& tour);
+    // Reconstruye las rutas desde anterior[fila * (n + 1) + ...]
+    void armarRutas(int n, int fila, std::vector<std::vector<int>>& rutas) const;
+};
+
+// Concatena los clientes de las rutas (sin los depósitos)
+std::vector<int> tourGigante(const std::vector<std::vector<int>>& rutas);
+
+// Split del tour respetando getNumVehicles() del reader
+Solution solucionDesdeTour(const VRPLIBReader& reader, const std::vector<int>& tour);
+
+#endif // SPLIT_H
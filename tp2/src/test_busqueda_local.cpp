@@ -0,0 +1,239 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "busqueda_local.h"
+#include "vnd.h"
+#include "recocido.h"
+
+// Instancia chica: depósito 1 en (0,0) y clientes en dos filas, demanda 10 c/u
+static const std::vector<double> xs = {0, 0, 10, 20, 0, 10, 20};
+static const std::vector<double> ys = {0, 0, 0, 0, 10, 10, 10};
+
+double costoRutas(const std::vector<std::vector<int>>& rutas, const DistanceMatrix& d) {
+    double total = 0.0;
+    for (const auto& ruta : rutas)
+        for (size_t i = 0; i + 1 < ruta.size(); ++i) total += d(ruta[i], ruta[i + 1]);
+    return total;
+}
+
+// El estado cacheado tiene que coincidir con recalcular todo desde cero
+void verificarEstado(const EstadoRutas& estado, const ContextoBusqueda& ctx) {
+    double total = 0.0;
+    for (size_t r = 0; r < estado.rutas.size(); ++r) {
+        const auto& ruta = estado.rutas[r];
+        int carga = 0;
+        assert(estado.carga_acum[r].size() == ruta.size());
+        for (size_t i = 1; i + 1 < ruta.size(); ++i) {
+            carga += ctx.demandas[ruta[i]];
+            assert(estado.carga_acum[r][i] == carga);
+            assert(estado.ruta_de[ruta[i]] == static_cast<int>(r));
+            assert(estado.pos_de[ruta[i]] == static_cast<int>(i));
+        }
+        assert(carga == estado.carga[r]);
+        assert(carga <= ctx.capacidad);
+        double costo = 0.0;
+        for (size_t i = 0; i + 1 < ruta.size(); ++i) costo += ctx.distancias(ruta[i], ruta[i + 1]);
+        assert(std::abs(costo - estado.costo[r]) < 1e-6);
+        total += costo;
+    }
+    assert(std::abs(total - estado.costoTotal()) < 1e-6);
+}
+
+// Cada cliente aparece exactamente una vez
+void verificarClientes(const std::vector<std::vector<int>>& rutas,
+                       const std::vector<int>& esperados = {2, 3, 4, 5, 6}) {
+    std::vector<int> vistos;
+    for (const auto& ruta : rutas) {
+        assert(ruta.front() == 1 && ruta.back() == 1);
+        for (size_t i = 1; i + 1 < ruta.size(); ++i) vistos.push_back(ruta[i]);
+    }
+    std::sort(vistos.begin(), vistos.end());
+    assert(vistos == esperados);
+}
+
+int main() {
+    DistanceMatrix distancias(7);
+    distancias.fillEuclidean(xs, ys, 1);
+    std::vector<int> demandas = {0, 0, 10, 10, 10, 10, 10};
+    int capacidad = 30;
+    NeighborIndex vecinos(distancias, 3, 1);
+
+    // Rutas cruzadas: cambiar 6 por 3 las descruza
+    std::vector<std::vector<int>> rutas = {{1, 2, 6, 1}, {1, 5, 3, 4, 1}};
+    double costo_inicial = costoRutas(rutas, distancias);
+
+    const NeighborIndex* listas[] = {nullptr, &vecinos};
+    for (const NeighborIndex* v : listas) {
+        for (ModoBusqueda modo : {ModoBusqueda::PrimeraMejora, ModoBusqueda::MejorMejora}) {
+            ContextoBusqueda ctx{distancias, demandas, capacidad, v, modo};
+
+            // 1) Swap: la variación devuelta coincide con el costo recalculado
+            EstadoRutas estado(rutas, ctx);
+            double delta = mejorarSwap(estado, ctx);
+            assert(delta < 0);
+            verificarEstado(estado, ctx);
+            verificarClientes(estado.rutas);
+            assert(std::abs(costo_inicial + delta - costoRutas(estado.rutas, distancias)) < 1e-6);
+
+            // 2) La interfaz por vectores da el mismo resultado
+            auto swap = BusquedaLocalSwap(rutas, distancias, demandas, capacidad, v, modo);
+            assert(swap == estado.rutas);
+        }
+
+        // 3) 2-opt: las aristas 2-6 y 3-5 se cruzan; al descruzarlas queda el
+        // perímetro del rectángulo
+        ContextoBusqueda ctx{distancias, demandas, 50, v};
+        EstadoRutas estado({{1, 2, 6, 3, 5, 4, 1}}, ctx);
+        double delta = mejorar2opt(estado, ctx);
+        assert(delta < 0);
+        verificarEstado(estado, ctx);
+        assert(std::abs(estado.costoTotal() - 60.0) < 1e-6);
+        for (int u = 2; u <= 6; ++u) assert(!estado.mirar[u]);
+
+        // Sin nodos marcados no hay nada que revisar
+        assert(mejorar2opt(estado, ctx) == 0.0);
+        auto opt = busquedaLocal2opt({{1, 2, 6, 3, 5, 4, 1}}, distancias, v);
+        assert(std::abs(costoRutas(opt, distancias) - 60.0) < 1e-6);
+
+        for (ModoBusqueda modo : {ModoBusqueda::PrimeraMejora, ModoBusqueda::MejorMejora}) {
+            // 4) Relocate: conviene llevar el 4 a la otra ruta, que queda vacía
+            ContextoBusqueda ctx_rel{distancias, demandas, capacidad, v, modo};
+            EstadoRutas rel({{1, 2, 3, 1}, {1, 4, 1}}, ctx_rel);
+            double delta_rel = mejorarRelocate(rel, ctx_rel);
+            assert(delta_rel < 0);
+            assert(rel.rutas.size() == 1);
+            verificarEstado(rel, ctx_rel);
+            assert(std::abs(60.0 + delta_rel - rel.costoTotal()) < 1e-6);
+
+            // 5) Or-opt: la cadena 5-6 (o 2-3) se mueve entera y deja una ruta
+            ContextoBusqueda ctx_or{distancias, demandas, 40, v, modo};
+            EstadoRutas orOpt({{1, 2, 3, 1}, {1, 5, 6, 1}}, ctx_or);
+            double inicial = orOpt.costoTotal();
+            double delta_or = mejorarOrOpt(orOpt, ctx_or);
+            assert(delta_or < 0);
+            assert(orOpt.rutas.size() == 1);
+            verificarEstado(orOpt, ctx_or);
+            verificarClientes(orOpt.rutas, {2, 3, 5, 6});
+            assert(std::abs(inicial + delta_or - orOpt.costoTotal()) < 1e-6);
+
+            // La capacidad se respeta: con 30 no entra una cadena de dos
+            auto sin_cambio = BusquedaLocalOrOpt({{1, 2, 3, 1}, {1, 5, 6, 1}}, distancias, demandas, 30, v, modo);
+            assert(sin_cambio.size() == 2);
+
+            // 6) 2-opt*: las rutas 1-2-6-1 y 1-5-3-1 se cruzan; intercambiar
+            // las colas las descruza
+            ContextoBusqueda ctx_est{distancias, demandas, capacidad, v, modo};
+            EstadoRutas est({{1, 2, 6, 1}, {1, 5, 3, 1}}, ctx_est);
+            double antes = est.costoTotal();
+            double delta_est = mejorar2optEstrella(est, ctx_est);
+            assert(delta_est < 0);
+            verificarEstado(est, ctx_est);
+            verificarClientes(est.rutas, {2, 3, 5, 6});
+            assert(std::abs(antes + delta_est - est.costoTotal()) < 1e-6);
+            assert(est.costoTotal() < 50.0 + std::sqrt(200.0) + std::sqrt(500.0) + 1e-6);
+            auto estrella = BusquedaLocal2optEstrella({{1, 2, 6, 1}, {1, 5, 3, 1}}, distancias, demandas, capacidad, v, modo);
+            assert(estrella == est.rutas);
+        }
+    }
+
+    // 7) VND: el costo seguido con las variaciones coincide con el recalculado
+    {
+        ContextoBusqueda ctx{distancias, demandas, capacidad, &vecinos};
+        VND vnd = VND::estandar();
+        EstadoRutas estado(rutas, ctx);
+        double costo = vnd.ejecutar(estado, ctx);
+        verificarEstado(estado, ctx);
+        verificarClientes(estado.rutas);
+        assert(costo < costo_inicial);
+        assert(std::abs(costo - costoRutas(estado.rutas, distancias)) < 1e-6);
+
+        // Cada operador se llamó al menos una vez y el último no mejoró
+        double ganancia = 0.0;
+        for (const auto& est : vnd.getEstadisticas()) {
+            assert(est.llamadas >= 1);
+            ganancia += est.ganancia;
+        }
+        assert(vnd.getEstadisticas().back().llamadas > vnd.getEstadisticas().back().mejoras);
+        assert(std::abs(costo_inicial - ganancia - costo) < 1e-6);
+
+        // Contadores: cada mejora evaluó al menos un movimiento, y la última
+        // pasada recorrió todos los operadores sin mejorar
+        long long evaluados = 0;
+        for (const auto& est : vnd.getEstadisticas()) {
+            if (kEstadisticas) assert(est.evaluados >= est.mejoras);
+            evaluados += est.evaluados;
+        }
+        assert(evaluados == estado.evaluados);
+        assert(kEstadisticas == (evaluados > 0));
+        assert(vnd.getEjecuciones() == 1);
+        assert(vnd.getPasadas() >= 1);
+        VND copia = vnd;
+        vnd.sumarEstadisticas(copia);
+        assert(vnd.getPasadas() == 2 * copia.getPasadas());
+        vnd.reiniciarEstadisticas();
+        assert(vnd.getPasadas() == 0 && vnd.getEstadisticas()[0].evaluados == 0);
+
+        // Con el límite ya vencido no se llama a ningún operador
+        ContextoBusqueda vencido{distancias, demandas, capacidad, &vecinos};
+        vencido.limite = std::chrono::steady_clock::now();
+        EstadoRutas sin_tiempo(rutas, vencido);
+        assert(vnd.ejecutar(sin_tiempo, vencido) == sin_tiempo.costoTotal());
+        assert(sin_tiempo.rutas == rutas);
+        assert(vnd.getEstadisticas()[0].llamadas == 0);
+
+        bool lanzo = false;
+        try {
+            operadorPorNombre("3opt");
+        } catch (const std::runtime_error&) {
+            lanzo = true;
+        }
+        assert(lanzo);
+    }
+
+    // 8) Recocido simulado: con la misma semilla y presupuesto de evaluaciones
+    // da la misma solución, nunca peor que la inicial y con todos los clientes
+    {
+        ContextoBusqueda ctx{distancias, demandas, capacidad, &vecinos};
+        auto armar = [&]() {
+            Solution inicial;
+            for (const auto& ruta : rutas) {
+                int carga = 0;
+                for (int c : ruta) carga += demandas[c];
+                inicial.agregarRuta(ruta, distancias, carga);
+            }
+            return inicial;
+        };
+        ConfigRecocido config;
+        config.limite_ms = 0.0;
+        config.max_evaluaciones = 20000;
+        config.semilla = 7;
+        ResultadoRecocido a = recocidoSimulado(armar(), ctx, config);
+        ResultadoRecocido b = recocidoSimulado(armar(), ctx, config);
+        assert(a.solucion == b.solucion);
+        assert(a.estadisticas.evaluaciones == 20000);
+        assert(a.estadisticas.costo <= costo_inicial + 1e-9);
+        assert(std::abs(a.estadisticas.costo - costoRutas(a.solucion.getRutas(), distancias)) < 1e-6);
+        assert(std::abs(a.estadisticas.trayectoria.front().costo - costo_inicial) < 1e-6);
+        verificarClientes(a.solucion.getRutas());
+        for (const auto& ruta : a.solucion.getRutas()) {
+            int carga = 0;
+            for (int c : ruta) carga += demandas[c];
+            assert(carga <= capacidad && ruta.size() > 2);
+        }
+
+        bool lanzo = false;
+        try {
+            ContextoBusqueda sin_vecinos{distancias, demandas, capacidad};
+            recocidoSimulado(armar(), sin_vecinos, config);
+        } catch (const std::runtime_error&) {
+            lanzo = true;
+        }
+        assert(lanzo);
+    }
+
+    std::cout << "✅ Test de búsqueda local pasó correctamente." << std::endl;
+    return 0;
+}
@@ -2,16 +2,23 @@
 #include <vector>
 #include <cassert>
 #include <map>
+#include <cmath>
+#include <type_traits>
+#include <random>
 #include "CVRP_Solution.h"
 
 int main() {
     // 1) Matriz de distancias simulada (4 nodos: 0, 1, 2, 3)
-    std::vector<std::vector<double>> distancias = {
+    std::vector<std::vector<double>> tabla = {
         {0, 2, 3, 4},
         {2, 0, 1, 5},
         {3, 1, 0, 2},
         {4, 5, 2, 0}
     };
+    DistanceMatrix distancias(4);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            distancias.set(i, j, tabla[i][j]);
 
     // 2) Ruta válida (ida y vuelta desde el depósito)
     std::vector<int> ruta = {0, 2, 3, 0};
@@ -30,7 +37,7 @@ int main() {
     }
 
     // 5) Verificar el costo total calculado
-    double costo_esperado = distancias[0][2] + distancias[2][3] + distancias[3][0];
+    double costo_esperado = distancias(0, 2) + distancias(2, 3) + distancias(3, 0);
     assert(std::abs(sol.getCostoTotal() - costo_esperado) < 1e-6);
 
     // 6) Verificar factibilidad por capacidad (sin acceder a Solution::demandas)
@@ -50,6 +57,108 @@ int main() {
         assert(suma <= capacidad_vehiculo);
     }
 
+    // 7) Buffer plano: vistas por ruta, costo y carga cacheados, y ubicación
+    // O(1) de cada cliente
+    sol.agregarRuta({0, 1, 0}, distancias, 10);
+    assert(sol.cantidadRutas() == 2);
+    assert(sol.ruta(1).size() == 3 && sol.ruta(1)[1] == 1);
+    assert(sol.tamanioRuta(0) == 2 && sol.tamanioRuta(1) == 1);
+    assert(sol.costoRuta(1) == 4.0 && sol.cargaRuta(1) == 10);
+    assert(std::abs(sol.getCostoTotal() - costo_esperado - 4.0) < 1e-6);
+    assert(sol.rutaDeCliente(3) == 0 && sol.posicionDeCliente(3) == 2);
+    assert(sol.anterior(3) == 2 && sol.siguiente(3) == 0);
+    assert(sol.anterior(1) == 0 && sol.siguiente(1) == 0);
+    assert(!sol.contiene(0) && sol.contiene(1));
+
+    // Solo se mueve; clone() copia y se compara sin armar vectores
+    static_assert(!std::is_copy_constructible<Solution>::value, "Solution no se copia implícitamente");
+    Solution copia = sol.clone();
+    assert(copia == sol);
+    copia.limpiar();
+    assert(copia != sol && copia.cantidadRutas() == 0 && !copia.contiene(2));
+    copia.agregarRuta({0, 1, 0}, distancias, 10);
+    Solution movida = std::move(copia);
+    assert(movida.getRutas() == std::vector<std::vector<int>>({{0, 1, 0}}));
+
+    // 8) Movimientos: delta coincide con el costo recalculado y deshacer deja
+    // la solución exactamente como estaba
+    {
+        const int n = 13;  // depósito 0 y clientes 1..12
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<double> coord(0.0, 100.0);
+        std::vector<double> xs(n), ys(n);
+        for (int i = 0; i < n; ++i) { xs[i] = coord(gen); ys[i] = coord(gen); }
+        DistanceMatrix euclidea(n);
+        euclidea.fillEuclidean(xs, ys);
+        std::vector<int> demandas = {0, 4, 3, 5, 2, 6, 1, 4, 3, 2, 5, 3, 2};
+        int capacidad = 15;
+
+        Solution base;
+        base.enlazar(euclidea, demandas, capacidad);
+        for (const std::vector<int>& r : {std::vector<int>{0, 1, 2, 3, 0}, {0, 4, 5, 6, 7, 0}, {0, 8, 9, 10, 0}, {0, 11, 12, 0}}) {
+            int carga = 0;
+            for (int c : r) carga += demandas[c];
+            base.agregarRuta(r, euclidea, carga);
+        }
+        assert(base.verificar() && base.cargaHasta(1, 2) == 8);
+
+        auto costoReal = [&](const Solution& s) {
+            double total = 0.0;
+            for (const auto& r : s.getRutas()) total += s.calcularCostoRuta(r, euclidea);
+            return total;
+        };
+        auto probar = [&](auto mov) {
+            if (!base.factible(mov)) return false;
+            Solution antes = base.clone();
+            double d = base.delta(mov);
+            base.aplicar(mov);
+            assert(base.verificar());
+            assert(std::abs(antes.getCostoTotal() + d - costoReal(base)) < 1e-6);
+            base.deshacer(mov);
+            assert(base == antes && base.verificar());
+            // Queda aplicado para que los siguientes partan de otras rutas
+            base.aplicar(mov);
+            return true;
+        };
+
+        int aplicados = 0;
+        std::uniform_int_distribution<int> cliente(1, n - 1);
+        for (int k = 0; k < 400; ++k) {
+            int a = cliente(gen), b = cliente(gen);
+            int R = base.cantidadRutas();
+            int r1 = gen() % R, r2 = gen() % R;
+            int L1 = base.ruta(r1).size(), L2 = base.ruta(r2).size();
+            switch (k % 4) {
+                case 0:
+                    if (a != b) aplicados += probar(MovSwap{a, b});
+                    break;
+                case 1:
+                    aplicados += probar(MovRelocate{a, r1, 1 + static_cast<int>(gen() % (L1 - 1))});
+                    break;
+                case 2:
+                    if (L1 > 3) {
+                        int i = 1 + gen() % (L1 - 2), j = 1 + gen() % (L1 - 2);
+                        aplicados += probar(Mov2opt{r1, std::min(i, j), std::max(i, j)});
+                    }
+                    break;
+                default:
+                    aplicados += probar(Mov2optEstrella{r1, static_cast<int>(gen() % (L1 - 1)),
+                                                        r2, static_cast<int>(gen() % (L2 - 1))});
+            }
+        }
+        assert(aplicados > 100);
+    }
+
+    // 9) La matriz empaquetada (triangular) debe dar las mismas distancias
+    DistanceMatrix empaquetada(4, DistanceMatrix::Storage::PackedSymmetric);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j <= i; ++j)
+            empaquetada.set(i, j, tabla[i][j]);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            assert(empaquetada(i, j) == distancias(i, j));
+    assert(empaquetada.bytes() < distancias.bytes());
+
     std::cout << "✅ Test de Solution pasó correctamente." << std::endl;
     return 0;
 }
@@ -0,0 +1,157 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include "split.h"
+
+static const double INF = std::numeric_limits<double>::infinity();
+
+// Costo de visitar tour[i..j) en una sola ruta, o INF si excede la capacidad
+double costoTramo(const std::vector<int>& tour, int i, int j, const std::vector<int>& demanda,
+                  int capacidad, int deposito, const DistanceMatrix& d) {
+    int carga = 0;
+    for (int p = i; p < j; ++p) carga += demanda[tour[p]];
+    if (carga > capacidad) return INF;
+    double costo = d(deposito, tour[i]) + d(tour[j - 1], deposito);
+    for (int p = i; p + 1 < j; ++p) costo += d(tour[p], tour[p + 1]);
+    return costo;
+}
+
+// DP exacta O(n²·K): mejor[k][j] = costo mínimo de cubrir tour[0..j) con exactamente k rutas.
+// Con vehiculos < 0 no hay límite de flota.
+double splitExacto(const std::vector<int>& tour, int vehiculos, const std::vector<int>& demanda,
+                   int capacidad, int deposito, const DistanceMatrix& d) {
+    int n = static_cast<int>(tour.size());
+    int K = vehiculos < 0 ? n : std::min(vehiculos, n);
+    std::vector<std::vector<double>> mejor(K + 1, std::vector<double>(n + 1, INF));
+    mejor[0][0] = 0.0;
+    for (int k = 1; k <= K; ++k)
+        for (int j = 1; j <= n; ++j)
+            for (int i = 0; i < j; ++i) {
+                if (mejor[k - 1][i] == INF) continue;
+                double c = costoTramo(tour, i, j, demanda, capacidad, deposito, d);
+                mejor[k][j] = std::min(mejor[k][j], mejor[k - 1][i] + c);
+            }
+    double res = INF;
+    for (int k = 1; k <= K; ++k) res = std::min(res, mejor[k][n]);
+    return res;
+}
+
+// Verifica que las rutas partan el tour en orden, respeten capacidad y cuesten lo informado
+void verificarRutas(const std::vector<std::vector<int>>& rutas, const std::vector<int>& tour, double costo,
+                    const std::vector<int>& demanda, int capacidad, int deposito, const DistanceMatrix& d) {
+    std::vector<int> visitados;
+    double total = 0.0;
+    for (const auto& ruta : rutas) {
+        assert(ruta.size() >= 3);
+        assert(ruta.front() == deposito && ruta.back() == deposito);
+        int carga = 0;
+        for (size_t p = 1; p + 1 < ruta.size(); ++p) {
+            carga += demanda[ruta[p]];
+            visitados.push_back(ruta[p]);
+        }
+        assert(carga <= capacidad);
+        for (size_t p = 0; p + 1 < ruta.size(); ++p) total += d(ruta[p], ruta[p + 1]);
+    }
+    assert(visitados == tour);
+    assert(tourGigante(rutas) == tour);
+    assert(std::abs(total - costo) < 1e-6);
+}
+
+int main() {
+    std::mt19937 gen(12345);
+    const int deposito = 1;
+    int casos = 0;
+
+    // 1) Instancias aleatorias: ambas variantes contra la DP exacta
+    for (int iter = 0; iter < 300; ++iter) {
+        int n = 1 + static_cast<int>(gen() % 12);
+        int capacidad = 10 + static_cast<int>(gen() % 30);
+        std::uniform_real_distribution<double> coord(0.0, 100.0);
+        std::uniform_int_distribution<int> dem(1, capacidad);
+
+        // Ids 1..n+1, depósito 1; la matriz se indexa por id
+        std::vector<double> xs(n + 2, 0.0), ys(n + 2, 0.0);
+        std::vector<int> demanda(n + 2, 0);
+        std::vector<Cliente> clientes;
+        for (int id = 1; id <= n + 1; ++id) {
+            xs[id] = coord(gen);
+            ys[id] = coord(gen);
+            demanda[id] = id == deposito ? 0 : dem(gen);
+            clientes.push_back({id, xs[id], ys[id], demanda[id]});
+        }
+        DistanceMatrix d(n + 2);
+        d.fillEuclidean(xs, ys, 1);
+        InstanceView instancia(clientes, capacidad, &d);
+        Split split(instancia);
+
+        std::vector<int> tour(n);
+        std::iota(tour.begin(), tour.end(), 2);
+        std::shuffle(tour.begin(), tour.end(), gen);
+
+        std::vector<std::vector<int>> rutas;
+        double exacto = splitExacto(tour, -1, demanda, capacidad, deposito, d);
+        double costo = split.dividir(tour, rutas);
+        assert(exacto < INF);
+        assert(std::abs(costo - exacto) < 1e-6);
+        verificarRutas(rutas, tour, costo, demanda, capacidad, deposito, d);
+
+        int cargaTotal = std::accumulate(demanda.begin(), demanda.end(), 0);
+        int minimo = (cargaTotal + capacidad - 1) / capacidad;
+        for (int vehiculos = 1; vehiculos <= n + 1; ++vehiculos) {
+            double exactoK = splitExacto(tour, vehiculos, demanda, capacidad, deposito, d);
+            double costoK = split.dividir(tour, vehiculos, rutas);
+            if (exactoK == INF) {
+                assert(costoK == Split::INFACTIBLE);
+            } else {
+                assert(std::abs(costoK - exactoK) < 1e-6);
+                assert(static_cast<int>(rutas.size()) <= vehiculos);
+                verificarRutas(rutas, tour, costoK, demanda, capacidad, deposito, d);
+            }
+            // 2) Flota menor a la cota por capacidad: nunca hay solución
+            if (vehiculos < minimo) assert(costoK == Split::INFACTIBLE);
+            ++casos;
+        }
+    }
+
+    // 3) Flota insuficiente en una instancia fija: 4 clientes de demanda 6, capacidad 10
+    {
+        std::vector<double> xs = {0, 0, 10, 20, 30, 40};
+        std::vector<double> ys = {0, 0, 0, 0, 0, 0};
+        std::vector<Cliente> clientes = {{1, 0, 0, 0}, {2, 10, 0, 6}, {3, 20, 0, 6}, {4, 30, 0, 6}, {5, 40, 0, 6}};
+        DistanceMatrix d(6);
+        d.fillEuclidean(xs, ys, 1);
+        InstanceView instancia(clientes, 10, &d);
+        Split split(instancia);
+        std::vector<int> tour = {2, 3, 4, 5};
+        std::vector<std::vector<int>> rutas;
+
+        assert(split.dividir(tour, rutas) < Split::INFACTIBLE);
+        assert(rutas.size() == 4);
+        for (int vehiculos = 0; vehiculos < 4; ++vehiculos)
+            assert(split.dividir(tour, vehiculos, rutas) == Split::INFACTIBLE);
+        assert(std::abs(split.dividir(tour, 4, rutas) - 2 * (10 + 20 + 30 + 40)) < 1e-6);
+        assert(rutas.size() == 4);
+    }
+
+    // 4) Un cliente que no entra solo en un vehículo vuelve infactible ambas variantes
+    {
+        std::vector<double> xs = {0, 0, 10, 20};
+        std::vector<double> ys = {0, 0, 0, 0};
+        std::vector<Cliente> clientes = {{1, 0, 0, 0}, {2, 10, 0, 5}, {3, 20, 0, 15}};
+        DistanceMatrix d(4);
+        d.fillEuclidean(xs, ys, 1);
+        InstanceView instancia(clientes, 10, &d);
+        Split split(instancia);
+        std::vector<std::vector<int>> rutas;
+        assert(split.dividir({2, 3}, rutas) == Split::INFACTIBLE);
+        assert(split.dividir({2, 3}, 5, rutas) == Split::INFACTIBLE);
+    }
+
+    std::cout << "✅ Test de Split pasó correctamente (" << casos << " casos con flota limitada)." << std::endl;
+    return 0;
+}
@@ -1,6 +1,45 @@
 #include <iostream>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include "VRPLIBReader.h"
+#include "InstanceView.h"
+#include "SpatialGrid.h"
+
+// Escribe una instancia chica con pesos explícitos y verifica que se lea bien
+static void testPesosExplicitos(const std::string& formato, const std::string& pesos) {
+    std::string tmp = (std::filesystem::temp_directory_path() / ("test_vrplib_" + formato + ".vrp")).string();
+    {
+        std::ofstream out(tmp);
+        out << "NAME: explicita\r\n"
+            << "TYPE : CVRP\n"
+            << "DIMENSION : 3\n"
+            << "CAPACITY : 10\n"
+            << "EDGE_WEIGHT_TYPE : EXPLICIT\n"
+            << "EDGE_WEIGHT_FORMAT : " << formato << "\n"
+            << "NODE_COORD_TYPE : NO_COORDS\n"
+            << "EDGE_WEIGHT_SECTION\n" << pesos
+            << "DEMAND_SECTION\n1 0\n2 4\n3 5\n"
+            << "DEPOT_SECTION\n 1\n -1\nEOF\n";
+    }
+    VRPLIBReader reader(tmp);
+    std::remove(tmp.c_str());
+
+    assert(reader.getName() == "explicita");
+    assert(reader.getDimension() == 3);
+    assert(reader.getNodes().size() == 3);
+    assert(reader.getDepotId() == 1);
+    assert(reader.getDemands()[3] == 5);
+    assert(!reader.isPlanarEuclidean());
+    const auto& d = reader.getDistanceMatrix();
+    assert(d(1, 2) == 7 && d(2, 1) == 7);
+    assert(d(1, 3) == 8.5 && d(3, 1) == 8.5);
+    assert(d(2, 3) == 9 && d(3, 2) == 9);
+    assert(d(2, 2) == 0);
+}
 
 int main(int argc, char* argv[]) {
     if (argc < 2) {
@@ -23,7 +62,126 @@ int main(int argc, char* argv[]) {
 
     const auto& matriz = reader.getDistanceMatrix();
     assert(!matriz.empty());
-    assert(matriz.size() == static_cast<size_t>(reader.getDimension()) + 1);
+    assert(matriz.size() == reader.getDimension() + 1);
+    assert(matriz.getStride() % 8 == 0);
+    assert(reinterpret_cast<std::uintptr_t>(matriz.row(1)) % DistanceMatrix::kAlignment == 0);
+
+    // La version empaquetada debe coincidir con la completa
+    ReaderOptions opciones;
+    opciones.backend = DistanceBackend::Packed;
+    VRPLIBReader empaquetado(path, opciones);
+    const auto& tri = empaquetado.getDistanceMatrix();
+    assert(tri.getStorage() == DistanceMatrix::Storage::PackedSymmetric);
+    for (int i = 1; i <= reader.getDimension(); ++i)
+        for (int j = 1; j <= reader.getDimension(); ++j)
+            assert(tri(i, j) == matriz(i, j));
+
+    // El oráculo sobre coordenadas (sin matriz) también debe coincidir,
+    // tanto punto a punto como por filas desde la caché
+    opciones.backend = DistanceBackend::OnTheFly;
+    VRPLIBReader perezoso(path, opciones);
+    const auto& oraculo = perezoso.getDistanceMatrix();
+    assert(oraculo.getStorage() == DistanceMatrix::Storage::OnTheFly);
+    for (int i = 1; i <= reader.getDimension(); ++i) {
+        const double* fila = oraculo.row(i);
+        for (int j = 1; j <= reader.getDimension(); ++j) {
+            assert(oraculo(i, j) == matriz(i, j));
+            assert(fila[j] == matriz(i, j));
+        }
+    }
+
+    // Con un límite de memoria chico, Auto debe elegir el oráculo
+    ReaderOptions limitado;
+    limitado.maxDenseBytes = 1;
+    VRPLIBReader automatico(path, limitado);
+    assert(automatico.getDistanceMatrix().getStorage() == DistanceMatrix::Storage::OnTheFly);
+
+    // Vista densa: el depósito en el índice 0 y traducción id <-> índice
+    InstanceView instancia(reader);
+    assert(instancia.size() == static_cast<int>(nodos.size()));
+    assert(instancia.getDepotId() == reader.getDepotId());
+    assert(instancia.idOf(0) == reader.getDepotId());
+    for (int i = 0; i < instancia.size(); ++i) {
+        int id = instancia.idOf(i);
+        assert(instancia.indexOf(id) == i);
+        assert(instancia.demand(i) == reader.getDemands()[id]);
+        assert(instancia.x(i) == reader.getXs()[id] && instancia.y(i) == reader.getYs()[id]);
+    }
+    assert(instancia.indexOf(0) == -1);
+    std::vector<int> ruta = {reader.getDepotId()};
+    for (int i = 1; i < instancia.size() && i < 4; ++i) ruta.push_back(instancia.idOf(i));
+    ruta.push_back(reader.getDepotId());
+    double costo = 0.0;
+    for (size_t i = 0; i + 1 < ruta.size(); ++i) costo += matriz(ruta[i], ruta[i + 1]);
+    assert(instancia.routeCost(ruta) == costo);
+    assert(instancia.isPlanarEuclidean());
+
+    // Grilla: el más cercano que entra coincide con recorrer todos, también
+    // a medida que se sacan clientes
+    SpatialGrid grilla(instancia);
+    std::vector<std::pair<double, int>> cercanos;
+    for (int paso = 0; grilla.remaining() > 0; ++paso) {
+        int desde = paso % instancia.size();
+        int espacio = (paso * 7) % (instancia.getCapacity() + 1);
+        std::vector<std::pair<double, int>> todos;
+        for (int i = 1; i < instancia.size(); ++i) {
+            if (grilla.contains(i) && instancia.demand(i) <= espacio) {
+                todos.emplace_back(matriz(instancia.idOf(desde), instancia.idOf(i)), i);
+            }
+        }
+        std::sort(todos.begin(), todos.end());
+        assert(grilla.nearest(desde, espacio) == (todos.empty() ? -1 : todos[0].second));
+        grilla.nearest(desde, espacio, 3, cercanos);
+        todos.resize(std::min<size_t>(todos.size(), 3));
+        assert(cercanos == todos);
+        int quitar = 1 + (paso * 13) % (instancia.size() - 1);
+        while (!grilla.contains(quitar)) quitar = quitar % (instancia.size() - 1) + 1;
+        grilla.remove(quitar);
+    }
+    grilla.reset();
+    assert(grilla.remaining() == instancia.size() - 1);
+
+    testPesosExplicitos("FULL_MATRIX", "0 7 8.5\n7 0 9\n8.5 9 0\n");
+    testPesosExplicitos("LOWER_ROW", "7\n8.5 9\n");
+    testPesosExplicitos("LOWER_DIAG_ROW", "0 7 0 8.5 9 0\n");
+
+    // Caché binaria: la primera lectura la escribe, la segunda la mapea y
+    // tiene que devolver exactamente los mismos datos
+    std::string copia = (std::filesystem::temp_directory_path() / "test_vrplib_cache.dat").string();
+    std::filesystem::copy_file(path, copia, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::remove(copia + ".vrpbin");
+    ReaderOptions conCache;
+    conCache.useBinaryCache = true;
+    VRPLIBReader fallo(copia, conCache);
+    assert(!fallo.isFromBinary());
+    assert(std::filesystem::exists(copia + ".vrpbin"));
+    VRPLIBReader acierto(copia, conCache);
+    assert(acierto.isFromBinary());
+    assert(acierto.getDistanceMatrix().isView());
+    assert(acierto.getName() == reader.getName());
+    assert(acierto.getDimension() == reader.getDimension());
+    assert(acierto.getCapacity() == reader.getCapacity());
+    assert(acierto.getNumVehicles() == reader.getNumVehicles());
+    assert(acierto.getDepotId() == reader.getDepotId());
+    assert(acierto.getDemands() == reader.getDemands());
+    assert(acierto.getNodes().size() == nodos.size());
+    assert(acierto.getNeighbors().getK() == reader.getNeighbors().getK());
+    for (int i = 1; i <= reader.getDimension(); ++i) {
+        for (int j = 1; j <= reader.getDimension(); ++j)
+            assert(acierto.getDistanceMatrix()(i, j) == matriz(i, j));
+        auto a = acierto.getNeighbors().neighbors(i);
+        auto b = reader.getNeighbors().neighbors(i);
+        for (int t = 0; t < a.size(); ++t) assert(a[t] == b[t]);
+    }
+    // Con otras opciones la caché no sirve y se reescribe
+    ReaderOptions otraK = conCache;
+    otraK.numNeighbors = 3;
+    assert(!VRPLIBReader(copia, otraK).isFromBinary());
+    assert(VRPLIBReader(copia, otraK).isFromBinary());
+    // El .vrpbin también se puede abrir directamente
+    assert(VRPLIBReader(copia + ".vrpbin").getNeighbors().getK() == std::min(3, reader.getDimension() - 2));
+    std::filesystem::remove(copia);
+    std::filesystem::remove(copia + ".vrpbin");
 
     std::cout << "✅ Test de VRPLIBReader PASÓ correctamente." << std::endl;
     return 0;
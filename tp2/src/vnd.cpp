@@ -0,0 +1,134 @@
+#include "vnd.h"
+#include "Trace.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+OperadorBusqueda operadorPorNombre(const string& nombre) {
+    if (nombre == "relocate") return mejorarRelocate;
+    if (nombre == "swap") return mejorarSwap;
+    if (nombre == "2opt*") return mejorar2optEstrella;
+    if (nombre == "oropt") return mejorarOrOpt;
+    if (nombre == "2opt") return mejorar2opt;
+    throw runtime_error("Error: operador de búsqueda local desconocido: " + nombre);
+}
+
+VND& VND::agregar(const string& nombre, OperadorBusqueda operador) {
+    operadores.push_back(move(operador));
+    estadisticas.push_back(EstadisticasOperador{nombre});
+    nombresTraza.push_back(trace::intern(nombre));
+    return *this;
+}
+
+VND& VND::agregar(const string& nombre) {
+    return agregar(nombre, operadorPorNombre(nombre));
+}
+
+VND VND::estandar() {
+    VND vnd;
+    // Primero los movimientos entre rutas, que además pueden vaciar rutas
+    vnd.agregar("relocate").agregar("swap").agregar("2opt*").agregar("oropt").agregar("2opt");
+    return vnd;
+}
+
+double VND::ejecutar(EstadoRutas& estado, const ContextoBusqueda& ctx) {
+    TRACE_SCOPE("VND");
+    double costo = estado.costoTotal();
+    ++ejecuciones;
+
+    size_t k = 0;
+    while (k < operadores.size()) {
+        if (ctx.limite != chrono::steady_clock::time_point::max() && chrono::steady_clock::now() >= ctx.limite) {
+            break;
+        }
+        if (k == 0) ++pasadas;
+        long long evaluados = estado.evaluados;
+        auto inicio = chrono::steady_clock::now();
+        double delta;
+        {
+            trace::Scope traza(nombresTraza[k]);
+            delta = operadores[k](estado, ctx);
+        }
+        auto fin = chrono::steady_clock::now();
+
+        EstadisticasOperador& est = estadisticas[k];
+        ++est.llamadas;
+        est.evaluados += estado.evaluados - evaluados;
+        est.tiempo_ms += chrono::duration<double, milli>(fin - inicio).count();
+
+        if (delta < 0) {
+            costo += delta;
+            ++est.mejoras;
+            est.ganancia -= delta;
+            k = 0;  // Volver al primer vecindario
+        } else {
+            ++k;
+        }
+    }
+    return costo;
+}
+
+const vector<EstadisticasOperador>& VND::getEstadisticas() const {
+    return estadisticas;
+}
+
+int VND::getEjecuciones() const {
+    return ejecuciones;
+}
+
+long long VND::getPasadas() const {
+    return pasadas;
+}
+
+void VND::reiniciarEstadisticas() {
+    for (auto& est : estadisticas) {
+        est = EstadisticasOperador{est.nombre};
+    }
+    ejecuciones = 0;
+    pasadas = 0;
+}
+
+void VND::sumarEstadisticas(const VND& otro) {
+    if (otro.estadisticas.size() != estadisticas.size()) {
+        throw runtime_error("Error: los VND tienen distintos operadores");
+    }
+    for (size_t k = 0; k < estadisticas.size(); ++k) {
+        estadisticas[k].llamadas += otro.estadisticas[k].llamadas;
+        estadisticas[k].mejoras += otro.estadisticas[k].mejoras;
+        estadisticas[k].evaluados += otro.estadisticas[k].evaluados;
+        estadisticas[k].ganancia += otro.estadisticas[k].ganancia;
+        estadisticas[k].tiempo_ms += otro.estadisticas[k].tiempo_ms;
+    }
+    ejecuciones += otro.ejecuciones;
+    pasadas += otro.pasadas;
+}
+
+void VND::imprimirEstadisticas() const {
+    cout << fixed << setprecision(3);
+    for (const auto& est : estadisticas) {
+        cout << "  " << setw(9) << left << est.nombre << right
+             << " | Llamadas: " << est.llamadas
+             << " | Mejoras: " << est.mejoras;
+        if (kEstadisticas) cout << " | Evaluados: " << est.evaluados;
+        cout << " | Ganancia: " << est.ganancia
+             << " | Tiempo: " << est.tiempo_ms << " ms\n";
+    }
+    if (ejecuciones > 0) {
+        cout << "  Pasadas hasta converger: " << pasadas << " en " << ejecuciones << " ejecuciones\n";
+    }
+}
+
+/*
+-----------------------------------------------------------
+Complejidad del VND
+-----------------------------------------------------------
+
+Cada llamada a un operador cuesta lo que ese operador (ver busqueda_local.cpp).
+Como se vuelve al primero después de cada mejora, hay a lo sumo
+(#operadores) llamadas sin mejora entre dos mejoras. El costo total se
+actualiza en O(1) por llamada, en vez de recalcular la solución: O(n) o, con
+las búsquedas por id de main, O(n²).
+*/
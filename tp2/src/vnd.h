@@ -0,0 +1,66 @@
+#ifndef VND_H
+#define VND_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "busqueda_local.h"
+
+using namespace std;
+
+// Un operador de vecindario mejora el estado en el lugar y devuelve la
+// variación del costo total (<= 0), como mejorarSwap o mejorar2opt.
+using OperadorBusqueda = function<double(EstadoRutas&, const ContextoBusqueda&)>;
+
+// Operador registrado por nombre: "relocate", "swap", "2opt*", "oropt", "2opt".
+// Lanza runtime_error si el nombre no existe.
+OperadorBusqueda operadorPorNombre(const string& nombre);
+
+struct EstadisticasOperador {
+    string nombre;
+    int llamadas = 0;
+    int mejoras = 0;          // llamadas que bajaron el costo
+    long long evaluados = 0;  // movimientos evaluados (solo con kEstadisticas)
+    double ganancia = 0.0;    // costo ahorrado en total (>= 0)
+    double tiempo_ms = 0.0;
+};
+
+// Variable Neighborhood Descent: recorre los operadores en orden y, cada vez
+// que uno mejora, vuelve a empezar desde el primero. Termina cuando ninguno
+// mejora. El costo se sigue con las variaciones que devuelven los
+// operadores, sin recalcular la solución.
+class VND {
+public:
+    VND() = default;
+
+    // Agrega un operador al final de la lista
+    VND& agregar(const string& nombre, OperadorBusqueda operador);
+    VND& agregar(const string& nombre);
+
+    // Relocate, Swap, 2-opt*, Or-opt y 2-opt, en ese orden
+    static VND estandar();
+
+    // Mejora el estado hasta un óptimo local de todos los operadores (o hasta
+    // ctx.limite) y devuelve su costo total
+    double ejecutar(EstadoRutas& estado, const ContextoBusqueda& ctx);
+
+    const vector<EstadisticasOperador>& getEstadisticas() const;
+    // Llamadas a ejecutar y pasadas por la lista de operadores (cada vez que
+    // se empieza desde el primero), sumadas entre llamadas
+    int getEjecuciones() const;
+    long long getPasadas() const;
+    void reiniciarEstadisticas();
+    // Suma las estadísticas de otro VND con los mismos operadores (por
+    // ejemplo, la copia que usó otro hilo)
+    void sumarEstadisticas(const VND& otro);
+    void imprimirEstadisticas() const;
+
+private:
+    vector<OperadorBusqueda> operadores;
+    vector<EstadisticasOperador> estadisticas;
+    vector<const char*> nombresTraza;   // mismos nombres, para la traza
+    int ejecuciones = 0;
+    long long pasadas = 0;
+};
+
+#endif // VND_H